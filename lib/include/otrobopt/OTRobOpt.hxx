@@ -23,6 +23,7 @@
 #define OTROBOPT_OTROBOPT_HXX
 
 #include "otrobopt/SequentialMonteCarloRobustAlgorithm.hxx"
+#include "otrobopt/AdaptiveIntegrationRobustAlgorithm.hxx"
 #include "otrobopt/MeanMeasure.hxx"
 #include "otrobopt/VarianceMeasure.hxx"
 #include "otrobopt/MeanStandardDeviationTradeoffMeasure.hxx"
@@ -32,6 +33,8 @@
 #include "otrobopt/QuantileMeasure.hxx"
 #include "otrobopt/AggregatedMeasure.hxx"
 #include "otrobopt/MeasureFactory.hxx"
+#include "otrobopt/QuasiMonteCarloIntegration.hxx"
+#include "otrobopt/SparseGridIntegration.hxx"
 #include "otrobopt/SubsetInverseSampling.hxx"
 #include "otrobopt/InverseFORM.hxx"
 
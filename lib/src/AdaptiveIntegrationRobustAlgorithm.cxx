@@ -0,0 +1,210 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Robust optimization with an integration accuracy tightened along the solver
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/AdaptiveIntegrationRobustAlgorithm.hxx"
+#include <otrobopt/MeasureFunction.hxx>
+
+#include <openturns/PersistentObjectFactory.hxx>
+#include <openturns/ResourceMap.hxx>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+CLASSNAMEINIT(AdaptiveIntegrationRobustAlgorithm)
+
+static Factory<AdaptiveIntegrationRobustAlgorithm> Factory_AdaptiveIntegrationRobustAlgorithm;
+
+
+/* Default constructor */
+AdaptiveIntegrationRobustAlgorithm::AdaptiveIntegrationRobustAlgorithm()
+  : RobustOptimizationAlgorithm()
+  , initialMaximumError_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultInitialMaximumError"))
+  , finalMaximumError_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultFinalMaximumError"))
+  , errorReductionFactor_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultErrorReductionFactor"))
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+AdaptiveIntegrationRobustAlgorithm::AdaptiveIntegrationRobustAlgorithm (const RobustOptimizationProblem & problem,
+    const OptimizationAlgorithm & solver)
+  : RobustOptimizationAlgorithm(problem, solver)
+  , initialMaximumError_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultInitialMaximumError"))
+  , finalMaximumError_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultFinalMaximumError"))
+  , errorReductionFactor_(ResourceMap::GetAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultErrorReductionFactor"))
+{
+  // Nothing to do
+}
+
+/* Virtual constructor method */
+AdaptiveIntegrationRobustAlgorithm * AdaptiveIntegrationRobustAlgorithm::clone() const
+{
+  return new AdaptiveIntegrationRobustAlgorithm(*this);
+}
+
+/* Evaluation */
+void AdaptiveIntegrationRobustAlgorithm::run()
+{
+  const RobustOptimizationProblem robustProblem(getRobustProblem());
+  Point currentPoint(solver_.getStartingPoint());
+  if (currentPoint.getDimension() != getProblem().getObjective().getInputDimension())
+    throw InvalidArgumentException(HERE) << "Invalid starting point dimension (" << currentPoint.getDimension() << "), expected " << getProblem().getObjective().getInputDimension();
+
+  Scalar maximumError = std::max(initialMaximumError_, finalMaximumError_);
+  Bool convergence = false;
+  // The measures are kept between the steps to follow their smoothing bandwidth schedule
+  MeasureEvaluation robustnessMeasure;
+  MeasureEvaluation reliabilityMeasure;
+  if (robustProblem.hasRobustnessMeasure()) robustnessMeasure = robustProblem.getRobustnessMeasure();
+  if (robustProblem.hasReliabilityMeasure()) reliabilityMeasure = robustProblem.getReliabilityMeasure();
+
+  // reset result
+  setResult(OptimizationResult(robustProblem));
+
+  UnsignedInteger iterationNumber = 0;
+  while ((!convergence) && (iterationNumber <= getMaximumIterationNumber()))
+  {
+    OptimizationProblem problem(getProblem());
+    if (robustProblem.hasRobustnessMeasure())
+    {
+      robustnessMeasure.setMaximumError(maximumError);
+      problem.setObjective(MeasureFunction(robustnessMeasure));
+    }
+    if (robustProblem.hasReliabilityMeasure())
+    {
+      reliabilityMeasure.setMaximumError(maximumError);
+      problem.setInequalityConstraint(MeasureFunction(reliabilityMeasure));
+    }
+
+    OptimizationAlgorithm solver(solver_);
+    solver.setProblem(problem);
+    solver.setStartingPoint(currentPoint);
+    // The solver cannot resolve the measures beyond the accuracy of their integration
+    solver.setMaximumResidualError(maximumError);
+    solver.setMaximumConstraintError(maximumError);
+    LOGINFO(OSS() << "solve the problem with an integration accuracy of " << maximumError);
+    solver.run();
+    const OptimizationResult result(solver.getResult());
+    const Point newPoint(result.getOptimalPoint());
+    const Point newValue(result.getOptimalValue());
+    LOGINFO(OSS() << "current optimum=" << newPoint);
+
+    // Shrink the smoothing bandwidths of the chance measures along their schedule
+    Bool smoothingReduced = false;
+    if (robustProblem.hasRobustnessMeasure()) smoothingReduced = robustnessMeasure.reduceSmoothingBandwidth();
+    if (robustProblem.hasReliabilityMeasure()) smoothingReduced = reliabilityMeasure.reduceSmoothingBandwidth() || smoothingReduced;
+
+    const Scalar absoluteError = (newPoint - currentPoint).norm();
+    convergence = (maximumError <= finalMaximumError_) && !smoothingReduced && (absoluteError < getMaximumAbsoluteError());
+
+    // Tighten the integration at least by the reduction factor, down to the residual of the solver
+    const Scalar residualError = result.getResidualError();
+    maximumError = std::max(finalMaximumError_, std::min(errorReductionFactor_ * maximumError, residualError));
+
+    currentPoint = newPoint;
+    ++ iterationNumber;
+
+    // update result
+    result_.setIterationNumber(iterationNumber);
+    result_.store(currentPoint, newValue, absoluteError, 0.0, residualError, result.getConstraintError());
+
+    // callbacks
+    if (progressCallback_.first)
+    {
+      progressCallback_.first((100.0 * iterationNumber) / getMaximumIterationNumber(), progressCallback_.second);
+    }
+    if (stopCallback_.first && stopCallback_.first(stopCallback_.second))
+    {
+      LOGWARN(OSS() << "Optimization was stopped by user");
+      break;
+    }
+  }
+}
+
+/* Integration accuracy of the first step accessor */
+void AdaptiveIntegrationRobustAlgorithm::setInitialMaximumError(const Scalar initialMaximumError)
+{
+  if (!(initialMaximumError > 0.0)) throw InvalidArgumentException(HERE) << "The initial maximum error must be positive";
+  initialMaximumError_ = initialMaximumError;
+}
+
+Scalar AdaptiveIntegrationRobustAlgorithm::getInitialMaximumError() const
+{
+  return initialMaximumError_;
+}
+
+/* Integration accuracy of the last steps accessor */
+void AdaptiveIntegrationRobustAlgorithm::setFinalMaximumError(const Scalar finalMaximumError)
+{
+  if (!(finalMaximumError > 0.0)) throw InvalidArgumentException(HERE) << "The final maximum error must be positive";
+  finalMaximumError_ = finalMaximumError;
+}
+
+Scalar AdaptiveIntegrationRobustAlgorithm::getFinalMaximumError() const
+{
+  return finalMaximumError_;
+}
+
+/* Reduction of the integration accuracy between two steps accessor */
+void AdaptiveIntegrationRobustAlgorithm::setErrorReductionFactor(const Scalar errorReductionFactor)
+{
+  if (!(errorReductionFactor > 0.0) || !(errorReductionFactor < 1.0))
+    throw InvalidArgumentException(HERE) << "The error reduction factor must be in (0, 1)";
+  errorReductionFactor_ = errorReductionFactor;
+}
+
+Scalar AdaptiveIntegrationRobustAlgorithm::getErrorReductionFactor() const
+{
+  return errorReductionFactor_;
+}
+
+/* String converter */
+String AdaptiveIntegrationRobustAlgorithm::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << AdaptiveIntegrationRobustAlgorithm::GetClassName()
+      << ", initialMaximumError=" << initialMaximumError_
+      << ", finalMaximumError=" << finalMaximumError_
+      << ", errorReductionFactor=" << errorReductionFactor_;
+  return oss;
+}
+
+/* Method save() stores the object through the StorageManager */
+void AdaptiveIntegrationRobustAlgorithm::save(Advocate & adv) const
+{
+  RobustOptimizationAlgorithm::save(adv);
+  adv.saveAttribute("initialMaximumError_", initialMaximumError_);
+  adv.saveAttribute("finalMaximumError_", finalMaximumError_);
+  adv.saveAttribute("errorReductionFactor_", errorReductionFactor_);
+}
+
+/* Method load() reloads the object from the StorageManager */
+void AdaptiveIntegrationRobustAlgorithm::load(Advocate & adv)
+{
+  RobustOptimizationAlgorithm::load(adv);
+  adv.loadAttribute("initialMaximumError_", initialMaximumError_);
+  adv.loadAttribute("finalMaximumError_", finalMaximumError_);
+  adv.loadAttribute("errorReductionFactor_", errorReductionFactor_);
+}
+
+
+} /* namespace OTROBOPT */
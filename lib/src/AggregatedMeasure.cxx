@@ -56,6 +56,9 @@ AggregatedMeasure::AggregatedMeasure(const MeasureEvaluationCollection & collect
   for (UnsignedInteger i = 0; i < size; ++ i)
     funcColl[i] = collection_[i].getFunction();
   setFunction(AggregatedFunction(funcColl));
+  // The members on the same function and discrete distribution evaluate it once per node
+  MeasureEvaluationCache::Share(collection_);
+  updateFusedGroups();
 }
 
 /* Virtual constructor method */
@@ -64,22 +67,105 @@ AggregatedMeasure * AggregatedMeasure::clone() const
   return new AggregatedMeasure(*this);
 }
 
+/* Group the members that can reduce the same values of the function: they must
+   share the function, the discrete distribution and the PDF threshold */
+void AggregatedMeasure::updateFusedGroups()
+{
+  const UnsignedInteger size = collection_.getSize();
+  leaders_ = Indices(size);
+  leaders_.fill();
+  fused_ = Indices(size, 0);
+  Indices eligible(size, 0);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const MeasureEvaluationImplementation & measure = *collection_[i].getImplementation();
+    // Nested aggregations have no reduction of their own
+    eligible[i] = !measure.getDistribution().isContinuous() && (dynamic_cast<const AggregatedMeasure *>(&measure) == 0);
+    if (!eligible[i]) continue;
+    for (UnsignedInteger k = 0; k < i; ++ k)
+    {
+      if (!eligible[k] || (leaders_[k] != k)) continue;
+      const MeasureEvaluationImplementation & leader = *collection_[k].getImplementation();
+      if ((leader.getFunction().getImplementation() == measure.getFunction().getImplementation())
+          && (leader.getDistribution().getImplementation() == measure.getDistribution().getImplementation())
+          && (leader.getPDFThreshold() == measure.getPDFThreshold()))
+      {
+        leaders_[i] = k;
+        fused_[i] = 1;
+        fused_[k] = 1;
+        break;
+      }
+    }
+  }
+}
+
 /* Evaluation */
 Point AggregatedMeasure::operator()(const Point & inP) const
 {
   const UnsignedInteger outputDimension = getFunction().getOutputDimension();
   Point outP(outputDimension);
   const UnsignedInteger size = collection_.getSize();
+  // Values of the function on the support, computed once per group by its first member
+  Collection<Sample> values(size);
   UnsignedInteger index = 0;
   for (UnsignedInteger i = 0; i < size; ++ i)
   {
-    const Point outPi(collection_[i](inP));
+    Point outPi;
+    if (fused_[i])
+    {
+      const MeasureEvaluationImplementation & measure = *collection_[i].getImplementation();
+      if (leaders_[i] == i) values[i] = EvaluateSignificantSupport(measure, inP);
+      outPi = Reduce(measure, inP, values[leaders_[i]]);
+    }
+    else
+      outPi = collection_[i](inP);
     std::copy(outPi.begin(), outPi.end(), outP.begin() + index);
     index += outPi.getSize();
   }
   return outP;
 }
 
+Sample AggregatedMeasure::operator()(const Sample & inS) const
+{
+  const UnsignedInteger sampleSize = inS.getSize();
+  Sample outS(sampleSize, getFunction().getOutputDimension());
+  const UnsignedInteger size = collection_.getSize();
+  Collection<Sample> values(size);
+  UnsignedInteger index = 0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    Sample outSi;
+    if (fused_[i])
+    {
+      // The grid of (x, theta) values is evaluated once per group,
+      // then each member reduces the block of each design point
+      const MeasureEvaluationImplementation & measure = *collection_[i].getImplementation();
+      if (leaders_[i] == i) values[i] = EvaluateSignificantSupport(measure, inS);
+      const Sample & grid = values[leaders_[i]];
+      const UnsignedInteger supportSize = GetSignificantSupportSize(measure);
+      const UnsignedInteger gridDimension = grid.getDimension();
+      Sample valuesK(supportSize, gridDimension);
+      outSi = Sample(sampleSize, measure.getOutputDimension());
+      for (UnsignedInteger k = 0; k < sampleSize; ++ k)
+      {
+        for (UnsignedInteger n = 0; n < supportSize; ++ n)
+          for (UnsignedInteger j = 0; j < gridDimension; ++ j)
+            valuesK(n, j) = grid(k * supportSize + n, j);
+        outSi[k] = Reduce(measure, inS[k], valuesK);
+      }
+    }
+    else
+      // Each measure evaluates all the design points at once
+      outSi = collection_[i](inS);
+    const UnsignedInteger dimension = outSi.getDimension();
+    for (UnsignedInteger k = 0; k < sampleSize; ++ k)
+      for (UnsignedInteger j = 0; j < dimension; ++ j)
+        outS(k, index + j) = outSi(k, j);
+    index += dimension;
+  }
+  return outS;
+}
+
 
 /* Distribution accessor */
 void AggregatedMeasure::setDistribution(const Distribution & distribution)
@@ -87,8 +173,43 @@ void AggregatedMeasure::setDistribution(const Distribution & distribution)
   const UnsignedInteger size = collection_.getSize();
   for (UnsignedInteger i = 0; i < size; ++ i)
     collection_[i].setDistribution(distribution);
+  MeasureEvaluationCache::Share(collection_);
+  updateFusedGroups();
+}
+
+
+/* Requested accuracy of the integration, applied to all the members */
+void AggregatedMeasure::setMaximumError(const Scalar maximumError)
+{
+  MeasureEvaluationImplementation::setMaximumError(maximumError);
+  const UnsignedInteger size = collection_.getSize();
+  for (UnsignedInteger i = 0; i < size; ++ i)
+    collection_[i].setMaximumError(maximumError);
+}
+
+/* Error estimates of the members, empty if one of them is unknown */
+Point AggregatedMeasure::getLastError() const
+{
+  Point error;
+  const UnsignedInteger size = collection_.getSize();
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Point errorI(collection_[i].getLastError());
+    if (errorI.getDimension() == 0) return Point();
+    error.add(errorI);
+  }
+  return error;
 }
 
+/* Next step of the smoothing bandwidth schedules of the members */
+Bool AggregatedMeasure::reduceSmoothingBandwidth()
+{
+  Bool reduced = false;
+  const UnsignedInteger size = collection_.getSize();
+  for (UnsignedInteger i = 0; i < size; ++ i)
+    reduced = collection_[i].reduceSmoothingBandwidth() || reduced;
+  return reduced;
+}
 
 Distribution AggregatedMeasure::getDistribution() const
 {
@@ -120,6 +241,7 @@ void AggregatedMeasure::load(Advocate & adv)
 {
   MeasureEvaluationImplementation::load(adv);
   adv.loadAttribute("collection_", collection_);
+  updateFusedGroups();
 }
 
 
@@ -22,13 +22,7 @@
 #include <openturns/PersistentObjectFactory.hxx>
 #include <openturns/GaussKronrod.hxx>
 #include <openturns/IteratedQuadrature.hxx>
-
-#if OPENTURNS_VERSION >= 102700
-#include <openturns/FiniteDiscreteDistribution.hxx>
-#else
-#include <openturns/UserDefined.hxx>
-#define FiniteDiscreteDistribution UserDefined
-#endif
+#include <openturns/DistFunc.hxx>
 
 using namespace OT;
 
@@ -43,11 +37,15 @@ static Factory<IndividualChanceMeasure> Factory_IndividualChanceMeasure;
 /* Default constructor */
 IndividualChanceMeasure::IndividualChanceMeasure()
   : MeasureEvaluationImplementation()
+  , smoothingBandwidth_(ResourceMap::GetAsScalar("IndividualChanceMeasure-SmoothingBandwidth"))
+  , finalSmoothingBandwidth_(ResourceMap::GetAsScalar("IndividualChanceMeasure-FinalSmoothingBandwidth"))
+  , smoothingBandwidthReductionFactor_(ResourceMap::GetAsScalar("IndividualChanceMeasure-SmoothingBandwidthReductionFactor"))
+  , importanceSamplingSize_(ResourceMap::GetAsUnsignedInteger("IndividualChanceMeasure-ImportanceSamplingSize"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("IndividualChanceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Parameter constructor */
@@ -57,12 +55,16 @@ IndividualChanceMeasure::IndividualChanceMeasure (const Function & function,
     const Point & alpha)
   : MeasureEvaluationImplementation(function, distribution)
   , operator_(op)
+  , smoothingBandwidth_(ResourceMap::GetAsScalar("IndividualChanceMeasure-SmoothingBandwidth"))
+  , finalSmoothingBandwidth_(ResourceMap::GetAsScalar("IndividualChanceMeasure-FinalSmoothingBandwidth"))
+  , smoothingBandwidthReductionFactor_(ResourceMap::GetAsScalar("IndividualChanceMeasure-SmoothingBandwidthReductionFactor"))
+  , importanceSamplingSize_(ResourceMap::GetAsUnsignedInteger("IndividualChanceMeasure-ImportanceSamplingSize"))
 {
   setAlpha(alpha);
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("IndividualChanceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Virtual constructor method */
@@ -72,18 +74,25 @@ IndividualChanceMeasure * IndividualChanceMeasure::clone() const
 }
 
 
+/* For a given value of x and of \Theta, it returns p(\Theta) * 1_{f_k(x,\Theta) >= 0} for each marginal.
+   When the bandwidth h is positive the indicator is smoothed into \Phi(f_k / h), and the values can be
+   followed by their gradients p(\Theta) * \phi(f_k / h) / h * \nabla_x f_k computed on the same node */
 class IndividualChanceMeasureParametricFunctionWrapper : public FunctionImplementation
 {
 public:
   IndividualChanceMeasureParametricFunctionWrapper (const Point & x,
       const Function & function,
       const Distribution & distribution,
-      const Scalar pdfThreshold)
+      const Scalar pdfThreshold,
+      const Scalar bandwidth = 0.0,
+      const Bool withGradient = false)
     : FunctionImplementation()
     , x_(x)
     , function_(function)
     , distribution_(distribution)
     , pdfThreshold_(pdfThreshold)
+    , bandwidth_(bandwidth)
+    , withGradient_(withGradient && (bandwidth > 0.0))
   {
     // Nothing to do
   }
@@ -97,20 +106,35 @@ public:
   {
     const Scalar pdf = distribution_.computePDF(theta);
     const UnsignedInteger outputDimension = function_.getOutputDimension();
-    Point outP(outputDimension);
+    Point outP(getOutputDimension());
     if (pdf <= pdfThreshold_) return outP;
     Function function(function_);
     function.setParameter(theta);
     Point y(function(x_));
-    for (UnsignedInteger j = 0; j < getOutputDimension(); ++ j)
-      outP[j] = (y[j] >= 0.0) ? pdf : 0.0;
+    if (!(bandwidth_ > 0.0))
+    {
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        outP[j] = (y[j] >= 0.0) ? pdf : 0.0;
+      return outP;
+    }
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      outP[j] = pdf * DistFunc::pNormal(y[j] / bandwidth_);
+    if (!withGradient_) return outP;
+    const UnsignedInteger inputDimension = function_.getInputDimension();
+    const Matrix gradient(function.gradient(x_));
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    {
+      const Scalar kernel = pdf * DistFunc::dNormal(y[j] / bandwidth_) / bandwidth_;
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        outP[outputDimension * (1 + i) + j] = kernel * gradient(i, j);
+    }
     return outP;
   }
 
   Sample operator()(const Sample & theta) const override
   {
     const UnsignedInteger size = theta.getSize();
-    Sample outS(size, function_.getOutputDimension());
+    Sample outS(size, getOutputDimension());
     for (UnsignedInteger i = 0; i < size; ++ i)
       outS[i] = operator()(theta[i]);
     return outS;
@@ -123,7 +147,8 @@ public:
 
   UnsignedInteger getOutputDimension() const override
   {
-    return function_.getOutputDimension();
+    const UnsignedInteger outputDimension = function_.getOutputDimension();
+    return withGradient_ ? outputDimension * (1 + function_.getInputDimension()) : outputDimension;
   }
 
   Description getInputDescription() const override
@@ -133,7 +158,7 @@ public:
 
   Description getOutputDescription() const override
   {
-    return function_.getOutputDescription();
+    return withGradient_ ? Description::BuildDefault(getOutputDimension(), "y") : function_.getOutputDescription();
   }
 
 protected:
@@ -141,6 +166,8 @@ protected:
   Function function_;
   Distribution distribution_;
   Scalar pdfThreshold_;
+  Scalar bandwidth_ = 0.0;
+  Bool withGradient_ = false;
 };
 
 
@@ -150,39 +177,96 @@ Point IndividualChanceMeasure::operator()(const Point & inP) const
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
-  if (getDistribution().isContinuous())
+  if ((importanceSamplingSize_ > 0) && getDistribution().isContinuous())
+  {
+    // Each marginal has its own proposal, centred on the satisfaction of the constraint for a small
+    // alpha and on its violation otherwise
+    Point error(outputDimension);
+    for (UnsignedInteger k = 0; k < outputDimension; ++ k)
+    {
+      const Bool complement = (alpha_[k] > 0.5);
+      Scalar variance = 0.0;
+      const Scalar probability = computeImportanceSampling(inP, Indices(1, k), complement, smoothingBandwidth_, k, importanceSamplingSize_, variance);
+      outP[k] = complement ? 1.0 - probability : probability;
+      error[k] = std::sqrt(variance);
+    }
+    setLastError(error);
+  }
+  else if (!hasSignificantSupport())
   {
-    Pointer<FunctionImplementation> p_wrapper(new IndividualChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_));
+    Pointer<FunctionImplementation> p_wrapper(new IndividualChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_, smoothingBandwidth_));
     const Function G(p_wrapper);
-    outP = integrationAlgorithm_.integrate(G, getDistribution().getRange());
+    Point error;
+    outP = computeIntegral(G, error);
+    setLastError(error);
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    Sample values(0, outputDimension);
-    Point weights(0);
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-          weights.add(pdfs[i]);
-        }
-    }
-    // Here we compute the marginal complementary CDF locally to avoid
-    // the creation cost of the marginal FiniteDiscreteDistribution distributions
-    for (UnsignedInteger i = 0; i < weights.getSize(); ++ i)
+    return reduce(inP, evaluateSignificantSupport(inP));
+  } // discrete
+  return operator_.operator()(1.0, 2.0) ? alpha_ - outP : outP - alpha_;
+}
+
+/* Importance sampling takes precedence over the nodes of a fixed rule for a sample too */
+Sample IndividualChanceMeasure::operator()(const Sample & inS) const
+{
+  if ((importanceSamplingSize_ > 0) && getDistribution().isContinuous())
+    return EvaluationImplementation::operator()(inS);
+  return MeasureEvaluationImplementation::operator()(inS);
+}
+
+/* Gradient.
+   With a positive smoothing bandwidth h the measure is \pm(\alpha_k - \mathbb{E}(\Phi(f_k / h))),
+   its gradient \mp\mathbb{E}(\phi(f_k / h) / h \nabla_x f_k) is computed along with the values on the
+   same nodes. The hard indicator has a null gradient almost everywhere, finite differences are kept.
+   They are also used with importance sampling, whose nodes are common to the neighbouring design points */
+Matrix IndividualChanceMeasure::gradient(const Point & inP) const
+{
+  if (!(smoothingBandwidth_ > 0.0) || ((importanceSamplingSize_ > 0) && getDistribution().isContinuous()))
+    return MeasureEvaluationImplementation::gradient(inP);
+  Function function(getFunction());
+  const UnsignedInteger inputDimension = function.getInputDimension();
+  const UnsignedInteger outputDimension = function.getOutputDimension();
+  Matrix result(inputDimension, outputDimension);
+  if (!hasSignificantSupport())
+  {
+    Pointer<FunctionImplementation> p_wrapper(new IndividualChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_, smoothingBandwidth_, true));
+    const Function G(p_wrapper);
+    const Point integral(integrationAlgorithm_.integrate(G, getDistribution().getRange()));
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        result(i, j) = integral[outputDimension * (1 + i) + j];
+  }
+  else
+  {
+    const Point & weights(getSignificantWeights());
+    const Sample values(evaluateSignificantSupport(inP));
+    for (UnsignedInteger k = 0; k < values.getSize(); ++ k)
     {
+      // The gradient of f is only needed where one of the kernels is not negligible
+      Bool significant = false;
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        significant = significant || (std::abs(values(k, j)) <= KernelSupport * smoothingBandwidth_);
+      if (!significant) continue;
+      const Matrix gradient(computeSignificantGradient(function, inP, k));
       for (UnsignedInteger j = 0; j < outputDimension; ++ j)
       {
-        if (values(i, j) >= 0.0)
-          outP[j] += weights[j];
-      } // for j
-    } // for i
-  } // discrete
+        const Scalar kernel = weights[k] * DistFunc::dNormal(values(k, j) / smoothingBandwidth_) / smoothingBandwidth_;
+        for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+          result(i, j) += kernel * gradient(i, j);
+      }
+    }
+  }
+  return operator_.operator()(1.0, 2.0) ? result * (-1.0) : result;
+}
+
+/* Reduction of the function values over the retained discrete support */
+Point IndividualChanceMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  // Here we compute the marginal complementary CDF locally to avoid
+  // the creation cost of the marginal FiniteDiscreteDistribution distributions
+  const Point outP(smoothingBandwidth_ > 0.0 ? ComputeWeightedSmoothedExceedance(values, weights, smoothingBandwidth_) : ComputeWeightedExceedance(values, weights));
   return operator_.operator()(1.0, 2.0) ? alpha_ - outP : outP - alpha_;
 }
 
@@ -203,6 +287,65 @@ Point IndividualChanceMeasure::getAlpha() const
   return alpha_;
 }
 
+/* Smoothing bandwidth accessor */
+void IndividualChanceMeasure::setSmoothingBandwidth(const Scalar smoothingBandwidth)
+{
+  if (!(smoothingBandwidth >= 0.0))
+    throw InvalidArgumentException(HERE) << "The smoothing bandwidth should be nonnegative";
+  smoothingBandwidth_ = smoothingBandwidth;
+}
+
+Scalar IndividualChanceMeasure::getSmoothingBandwidth() const
+{
+  return smoothingBandwidth_;
+}
+
+/* Smoothing bandwidth at the end of the schedule accessor */
+void IndividualChanceMeasure::setFinalSmoothingBandwidth(const Scalar finalSmoothingBandwidth)
+{
+  if (!(finalSmoothingBandwidth >= 0.0))
+    throw InvalidArgumentException(HERE) << "The final smoothing bandwidth should be nonnegative";
+  finalSmoothingBandwidth_ = finalSmoothingBandwidth;
+}
+
+Scalar IndividualChanceMeasure::getFinalSmoothingBandwidth() const
+{
+  return finalSmoothingBandwidth_;
+}
+
+/* Reduction of the smoothing bandwidth between two steps of the schedule accessor */
+void IndividualChanceMeasure::setSmoothingBandwidthReductionFactor(const Scalar smoothingBandwidthReductionFactor)
+{
+  if (!(smoothingBandwidthReductionFactor > 0.0) || !(smoothingBandwidthReductionFactor < 1.0))
+    throw InvalidArgumentException(HERE) << "The smoothing bandwidth reduction factor should be in (0, 1)";
+  smoothingBandwidthReductionFactor_ = smoothingBandwidthReductionFactor;
+}
+
+Scalar IndividualChanceMeasure::getSmoothingBandwidthReductionFactor() const
+{
+  return smoothingBandwidthReductionFactor_;
+}
+
+/* Next step of the smoothing bandwidth schedule: the bandwidth is multiplied by the reduction
+   factor down to the final bandwidth. A null final bandwidth means no schedule */
+Bool IndividualChanceMeasure::reduceSmoothingBandwidth()
+{
+  if (!(finalSmoothingBandwidth_ > 0.0) || !(smoothingBandwidth_ > finalSmoothingBandwidth_)) return false;
+  smoothingBandwidth_ = std::max(finalSmoothingBandwidth_, smoothingBandwidthReductionFactor_ * smoothingBandwidth_);
+  return true;
+}
+
+/* Importance sampling size accessor */
+void IndividualChanceMeasure::setImportanceSamplingSize(const UnsignedInteger importanceSamplingSize)
+{
+  importanceSamplingSize_ = importanceSamplingSize;
+}
+
+UnsignedInteger IndividualChanceMeasure::getImportanceSamplingSize() const
+{
+  return importanceSamplingSize_;
+}
+
 /* String converter */
 String IndividualChanceMeasure::__repr__() const
 {
@@ -218,6 +361,10 @@ void IndividualChanceMeasure::save(Advocate & adv) const
   MeasureEvaluationImplementation::save(adv);
   adv.saveAttribute("alpha_", alpha_);
   adv.saveAttribute("operator_", operator_);
+  adv.saveAttribute("smoothingBandwidth_", smoothingBandwidth_);
+  adv.saveAttribute("finalSmoothingBandwidth_", finalSmoothingBandwidth_);
+  adv.saveAttribute("smoothingBandwidthReductionFactor_", smoothingBandwidthReductionFactor_);
+  adv.saveAttribute("importanceSamplingSize_", importanceSamplingSize_);
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -226,6 +373,14 @@ void IndividualChanceMeasure::load(Advocate & adv)
   MeasureEvaluationImplementation::load(adv);
   adv.loadAttribute("alpha_", alpha_);
   adv.loadAttribute("operator_", operator_);
+  if (adv.hasAttribute("smoothingBandwidth_"))
+    adv.loadAttribute("smoothingBandwidth_", smoothingBandwidth_);
+  if (adv.hasAttribute("finalSmoothingBandwidth_"))
+    adv.loadAttribute("finalSmoothingBandwidth_", finalSmoothingBandwidth_);
+  if (adv.hasAttribute("smoothingBandwidthReductionFactor_"))
+    adv.loadAttribute("smoothingBandwidthReductionFactor_", smoothingBandwidthReductionFactor_);
+  if (adv.hasAttribute("importanceSamplingSize_"))
+    adv.loadAttribute("importanceSamplingSize_", importanceSamplingSize_);
 }
 
 
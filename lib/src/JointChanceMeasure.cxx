@@ -22,6 +22,7 @@
 #include <openturns/PersistentObjectFactory.hxx>
 #include <openturns/GaussKronrod.hxx>
 #include <openturns/IteratedQuadrature.hxx>
+#include <openturns/DistFunc.hxx>
 
 using namespace OT;
 
@@ -36,11 +37,15 @@ static Factory<JointChanceMeasure> Factory_JointChanceMeasure;
 /* Default constructor */
 JointChanceMeasure::JointChanceMeasure()
   : MeasureEvaluationImplementation()
+  , smoothingBandwidth_(ResourceMap::GetAsScalar("JointChanceMeasure-SmoothingBandwidth"))
+  , finalSmoothingBandwidth_(ResourceMap::GetAsScalar("JointChanceMeasure-FinalSmoothingBandwidth"))
+  , smoothingBandwidthReductionFactor_(ResourceMap::GetAsScalar("JointChanceMeasure-SmoothingBandwidthReductionFactor"))
+  , importanceSamplingSize_(ResourceMap::GetAsUnsignedInteger("JointChanceMeasure-ImportanceSamplingSize"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("JointChanceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Parameter constructor */
@@ -50,13 +55,17 @@ JointChanceMeasure::JointChanceMeasure (const Function & function,
                                         const Scalar alpha)
   : MeasureEvaluationImplementation(function, distribution)
   , operator_(op)
+  , smoothingBandwidth_(ResourceMap::GetAsScalar("JointChanceMeasure-SmoothingBandwidth"))
+  , finalSmoothingBandwidth_(ResourceMap::GetAsScalar("JointChanceMeasure-FinalSmoothingBandwidth"))
+  , smoothingBandwidthReductionFactor_(ResourceMap::GetAsScalar("JointChanceMeasure-SmoothingBandwidthReductionFactor"))
+  , importanceSamplingSize_(ResourceMap::GetAsUnsignedInteger("JointChanceMeasure-ImportanceSamplingSize"))
 {
   setAlpha(alpha);
   setOutputDescription(Description(1, "P"));
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("JointChanceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Virtual constructor method */
@@ -66,18 +75,25 @@ JointChanceMeasure * JointChanceMeasure::clone() const
 }
 
 
+/* For a given value of x and of \Theta, it returns p(\Theta) * \prod_k 1_{f_k(x,\Theta) >= 0}.
+   When the bandwidth h is positive the indicators are smoothed into \Phi(f_k / h), and the value can be
+   followed by its gradient p(\Theta) * \sum_k \phi(f_k / h) / h \prod_{l \neq k} \Phi(f_l / h) \nabla_x f_k */
 class JointChanceMeasureParametricFunctionWrapper : public FunctionImplementation
 {
 public:
   JointChanceMeasureParametricFunctionWrapper(const Point & x,
       const Function & function,
       const Distribution & distribution,
-      const Scalar pdfThreshold)
+      const Scalar pdfThreshold,
+      const Scalar bandwidth = 0.0,
+      const Bool withGradient = false)
     : FunctionImplementation()
     , x_(x)
     , function_(function)
     , distribution_(distribution)
     , pdfThreshold_(pdfThreshold)
+    , bandwidth_(bandwidth)
+    , withGradient_(withGradient && (bandwidth > 0.0))
   {
     // Nothing to do
   }
@@ -90,22 +106,47 @@ public:
   Point operator()(const Point & theta) const override
   {
     const Scalar pdf = distribution_.computePDF(theta);
-    if (pdf <= pdfThreshold_) return Point(1, 0.0);
+    Point outP(getOutputDimension());
+    if (pdf <= pdfThreshold_) return outP;
     Function function(function_);
     function.setParameter(theta);
     const Point y(function(x_));
     const UnsignedInteger outputDimension = y.getDimension();
+    if (!(bandwidth_ > 0.0))
+    {
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        if (y[j] < 0.0) return outP;
+      outP[0] = pdf;
+      return outP;
+    }
+    Point cdf(outputDimension);
+    outP[0] = pdf;
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    {
+      cdf[j] = DistFunc::pNormal(y[j] / bandwidth_);
+      outP[0] *= cdf[j];
+    }
+    if (!withGradient_) return outP;
+    const UnsignedInteger inputDimension = function_.getInputDimension();
+    const Matrix gradient(function.gradient(x_));
     for (UnsignedInteger j = 0; j < outputDimension; ++ j)
-      if (y[j] < 0.0) return Point(1, 0.0);
-    return Point(1, pdf);
+    {
+      // Product of the other smoothed indicators, without dividing by cdf[j] which may vanish
+      Scalar kernel = pdf * DistFunc::dNormal(y[j] / bandwidth_) / bandwidth_;
+      for (UnsignedInteger l = 0; l < outputDimension; ++ l)
+        if (l != j) kernel *= cdf[l];
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        outP[1 + i] += kernel * gradient(i, j);
+    }
+    return outP;
   }
 
   Sample operator()(const Sample & theta) const override
   {
     const UnsignedInteger size = theta.getSize();
-    Sample outS(size, 1);
+    Sample outS(size, getOutputDimension());
     for (UnsignedInteger i = 0; i < size; ++ i)
-      outS(i, 0) = operator()(theta[i])[0];
+      outS[i] = operator()(theta[i]);
     return outS;
   }
 
@@ -116,7 +157,7 @@ public:
 
   UnsignedInteger getOutputDimension() const override
   {
-    return 1;
+    return withGradient_ ? 1 + function_.getInputDimension() : 1;
   }
 
   Description getInputDescription() const override
@@ -126,7 +167,7 @@ public:
 
   Description getOutputDescription() const override
   {
-    return Description(1, "P");
+    return withGradient_ ? Description::BuildDefault(getOutputDimension(), "P") : Description(1, "P");
   }
 
 protected:
@@ -134,6 +175,8 @@ protected:
   Function function_;
   Distribution distribution_;
   Scalar pdfThreshold_;
+  Scalar bandwidth_ = 0.0;
+  Bool withGradient_ = false;
 };
 
 
@@ -141,48 +184,102 @@ protected:
 Point JointChanceMeasure::operator()(const Point & inP) const
 {
   Function function(getFunction());
-  const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(1);
-  if (getDistribution().isContinuous())
+  if ((importanceSamplingSize_ > 0) && getDistribution().isContinuous())
+  {
+    // The rare event is the joint satisfaction of the constraints for a small alpha, their violation otherwise
+    const Bool complement = (alpha_ > 0.5);
+    Indices marginals(function.getOutputDimension());
+    marginals.fill();
+    Scalar variance = 0.0;
+    const Scalar probability = computeImportanceSampling(inP, marginals, complement, smoothingBandwidth_, 0, importanceSamplingSize_, variance);
+    outP[0] = complement ? 1.0 - probability : probability;
+    setLastError(Point(1, std::sqrt(variance)));
+  }
+  else if (!hasSignificantSupport())
   {
-    Pointer<FunctionImplementation> p_wrapper(new JointChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_));
+    Pointer<FunctionImplementation> p_wrapper(new JointChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_, smoothingBandwidth_));
     const Function G(p_wrapper);
-    outP = integrationAlgorithm_.integrate(G, getDistribution().getRange());
+    Point error;
+    outP = computeIntegral(G, error);
+    setLastError(error);
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    Sample values(0, outputDimension);
-    Point weights(0);
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-          weights.add(pdfs[i]);
-        }
-    }
-    // Here we compute the marginal complementary CDF locally to avoid
-    // the creation cost of the FiniteDiscreteDistribution distributions
-    for (UnsignedInteger i = 0; i < weights.getSize(); ++ i)
-    {
-      Bool allOk = true;
-      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
-        if (values(i, j) < 0.0)
-        {
-          allOk = false;
-          break;
-        }
-      if (allOk) outP[0] += weights[i];
-    } // for i
+    return reduce(inP, evaluateSignificantSupport(inP));
   }
   outP[0] = operator_.operator()(1.0, 2.0) ? alpha_ - outP[0] : outP[0] - alpha_;
   return outP;
 }
 
+/* Importance sampling takes precedence over the nodes of a fixed rule for a sample too */
+Sample JointChanceMeasure::operator()(const Sample & inS) const
+{
+  if ((importanceSamplingSize_ > 0) && getDistribution().isContinuous())
+    return EvaluationImplementation::operator()(inS);
+  return MeasureEvaluationImplementation::operator()(inS);
+}
+
+/* Gradient.
+   With a positive smoothing bandwidth h the measure is \pm(\alpha - \mathbb{E}(\prod_k \Phi(f_k / h))),
+   its gradient is computed along with the value on the same nodes. The hard indicator has a null
+   gradient almost everywhere, finite differences are kept. They are also used with importance sampling,
+   whose nodes are common to the neighbouring design points */
+Matrix JointChanceMeasure::gradient(const Point & inP) const
+{
+  if (!(smoothingBandwidth_ > 0.0) || ((importanceSamplingSize_ > 0) && getDistribution().isContinuous()))
+    return MeasureEvaluationImplementation::gradient(inP);
+  Function function(getFunction());
+  const UnsignedInteger inputDimension = function.getInputDimension();
+  const UnsignedInteger outputDimension = function.getOutputDimension();
+  Matrix result(inputDimension, 1);
+  if (!hasSignificantSupport())
+  {
+    Pointer<FunctionImplementation> p_wrapper(new JointChanceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_, smoothingBandwidth_, true));
+    const Function G(p_wrapper);
+    const Point integral(integrationAlgorithm_.integrate(G, getDistribution().getRange()));
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+      result(i, 0) = integral[1 + i];
+  }
+  else
+  {
+    const Point & weights(getSignificantWeights());
+    const Sample values(evaluateSignificantSupport(inP));
+    Point cdf(outputDimension);
+    for (UnsignedInteger k = 0; k < values.getSize(); ++ k)
+    {
+      // The gradient of f is only needed where one of the kernels is not negligible
+      Bool significant = false;
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      {
+        cdf[j] = DistFunc::pNormal(values(k, j) / smoothingBandwidth_);
+        significant = significant || (std::abs(values(k, j)) <= KernelSupport * smoothingBandwidth_);
+      }
+      if (!significant) continue;
+      const Matrix gradient(computeSignificantGradient(function, inP, k));
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      {
+        Scalar kernel = weights[k] * DistFunc::dNormal(values(k, j) / smoothingBandwidth_) / smoothingBandwidth_;
+        for (UnsignedInteger l = 0; l < outputDimension; ++ l)
+          if (l != j) kernel *= cdf[l];
+        for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+          result(i, 0) += kernel * gradient(i, j);
+      }
+    }
+  }
+  return operator_.operator()(1.0, 2.0) ? result * (-1.0) : result;
+}
+
+/* Reduction of the function values over the retained discrete support */
+Point JointChanceMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  // Here we compute the marginal complementary CDF locally to avoid
+  // the creation cost of the FiniteDiscreteDistribution distributions
+  const Scalar probability = (smoothingBandwidth_ > 0.0 ? ComputeWeightedSmoothedJointExceedance(values, weights, smoothingBandwidth_) : ComputeWeightedJointExceedance(values, weights));
+  return Point(1, operator_.operator()(1.0, 2.0) ? alpha_ - probability : probability - alpha_);
+}
+
 UnsignedInteger JointChanceMeasure::getOutputDimension() const
 {
   return 1;
@@ -201,6 +298,65 @@ Scalar JointChanceMeasure::getAlpha() const
   return alpha_;
 }
 
+/* Smoothing bandwidth accessor */
+void JointChanceMeasure::setSmoothingBandwidth(const Scalar smoothingBandwidth)
+{
+  if (!(smoothingBandwidth >= 0.0))
+    throw InvalidArgumentException(HERE) << "The smoothing bandwidth should be nonnegative";
+  smoothingBandwidth_ = smoothingBandwidth;
+}
+
+Scalar JointChanceMeasure::getSmoothingBandwidth() const
+{
+  return smoothingBandwidth_;
+}
+
+/* Smoothing bandwidth at the end of the schedule accessor */
+void JointChanceMeasure::setFinalSmoothingBandwidth(const Scalar finalSmoothingBandwidth)
+{
+  if (!(finalSmoothingBandwidth >= 0.0))
+    throw InvalidArgumentException(HERE) << "The final smoothing bandwidth should be nonnegative";
+  finalSmoothingBandwidth_ = finalSmoothingBandwidth;
+}
+
+Scalar JointChanceMeasure::getFinalSmoothingBandwidth() const
+{
+  return finalSmoothingBandwidth_;
+}
+
+/* Reduction of the smoothing bandwidth between two steps of the schedule accessor */
+void JointChanceMeasure::setSmoothingBandwidthReductionFactor(const Scalar smoothingBandwidthReductionFactor)
+{
+  if (!(smoothingBandwidthReductionFactor > 0.0) || !(smoothingBandwidthReductionFactor < 1.0))
+    throw InvalidArgumentException(HERE) << "The smoothing bandwidth reduction factor should be in (0, 1)";
+  smoothingBandwidthReductionFactor_ = smoothingBandwidthReductionFactor;
+}
+
+Scalar JointChanceMeasure::getSmoothingBandwidthReductionFactor() const
+{
+  return smoothingBandwidthReductionFactor_;
+}
+
+/* Next step of the smoothing bandwidth schedule: the bandwidth is multiplied by the reduction
+   factor down to the final bandwidth. A null final bandwidth means no schedule */
+Bool JointChanceMeasure::reduceSmoothingBandwidth()
+{
+  if (!(finalSmoothingBandwidth_ > 0.0) || !(smoothingBandwidth_ > finalSmoothingBandwidth_)) return false;
+  smoothingBandwidth_ = std::max(finalSmoothingBandwidth_, smoothingBandwidthReductionFactor_ * smoothingBandwidth_);
+  return true;
+}
+
+/* Importance sampling size accessor */
+void JointChanceMeasure::setImportanceSamplingSize(const UnsignedInteger importanceSamplingSize)
+{
+  importanceSamplingSize_ = importanceSamplingSize;
+}
+
+UnsignedInteger JointChanceMeasure::getImportanceSamplingSize() const
+{
+  return importanceSamplingSize_;
+}
+
 /* String converter */
 String JointChanceMeasure::__repr__() const
 {
@@ -216,6 +372,10 @@ void JointChanceMeasure::save(Advocate & adv) const
   MeasureEvaluationImplementation::save(adv);
   adv.saveAttribute("alpha_", alpha_);
   adv.saveAttribute("operator_", operator_);
+  adv.saveAttribute("smoothingBandwidth_", smoothingBandwidth_);
+  adv.saveAttribute("finalSmoothingBandwidth_", finalSmoothingBandwidth_);
+  adv.saveAttribute("smoothingBandwidthReductionFactor_", smoothingBandwidthReductionFactor_);
+  adv.saveAttribute("importanceSamplingSize_", importanceSamplingSize_);
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -224,6 +384,14 @@ void JointChanceMeasure::load(Advocate & adv)
   MeasureEvaluationImplementation::load(adv);
   adv.loadAttribute("alpha_", alpha_);
   adv.loadAttribute("operator_", operator_);
+  if (adv.hasAttribute("smoothingBandwidth_"))
+    adv.loadAttribute("smoothingBandwidth_", smoothingBandwidth_);
+  if (adv.hasAttribute("finalSmoothingBandwidth_"))
+    adv.loadAttribute("finalSmoothingBandwidth_", finalSmoothingBandwidth_);
+  if (adv.hasAttribute("smoothingBandwidthReductionFactor_"))
+    adv.loadAttribute("smoothingBandwidthReductionFactor_", smoothingBandwidthReductionFactor_);
+  if (adv.hasAttribute("importanceSamplingSize_"))
+    adv.loadAttribute("importanceSamplingSize_", importanceSamplingSize_);
 }
 
 
@@ -36,22 +36,24 @@ static Factory<MeanMeasure> Factory_MeanMeasure;
 /* Default constructor */
 MeanMeasure::MeanMeasure()
   : MeasureEvaluationImplementation()
+  , controlVariate_(ResourceMap::GetAsBool("MeanMeasure-ControlVariate"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("MeanMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Parameter constructor */
 MeanMeasure::MeanMeasure (const Function & function,
                           const Distribution & distribution)
   : MeasureEvaluationImplementation(function, distribution)
+  , controlVariate_(ResourceMap::GetAsBool("MeanMeasure-ControlVariate"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("MeanMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Virtual constructor method */
@@ -146,30 +148,114 @@ Point MeanMeasure::operator()(const Point & inP) const
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
-  if (getDistribution().isContinuous())
+  if (!hasSignificantSupport())
   {
     Pointer<FunctionImplementation> p_wrapper(new MeanMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_));
     const Function G(p_wrapper);
-    outP = integrationAlgorithm_.integrate(G, getDistribution().getRange());
+    Point error;
+    outP = computeIntegral(G, error);
+    setLastError(error);
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-      {
-        function.setParameter(parameters[i]);
-        outP += function(inP) * pdfs[i];
-      }
-    } // for
-  } // !isContinuous
+    // Evaluate the whole retained support at once, then reduce with the weights
+    outP = reduce(inP, evaluateSignificantSupport(inP));
+  } // hasSignificantSupport
   return outP;
 }
 
+/* Gradient: \nabla_x \mathbb{E}(f(x,\Theta)) = \mathbb{E}(\nabla_x f(x,\Theta)) */
+Matrix MeanMeasure::gradient(const Point & inP) const
+{
+  Point mean;
+  Point variance;
+  Matrix meanGradient;
+  Matrix varianceGradient;
+  SymmetricTensor meanHessian;
+  SymmetricTensor varianceHessian;
+  computeDerivativeMoments(inP, 1, mean, variance, meanGradient, varianceGradient, meanHessian, varianceHessian);
+  // The discrete mean is the sum of the weighted values, which is not normalized
+  // by the retained weights, unlike the moments
+  if (hasSignificantSupport()) meanGradient = meanGradient * getSignificantWeightSum();
+  return meanGradient;
+}
+
+/* Hessian: \nabla^2_x \mathbb{E}(f(x,\Theta)) = \mathbb{E}(\nabla^2_x f(x,\Theta)) */
+SymmetricTensor MeanMeasure::hessian(const Point & inP) const
+{
+  Point mean;
+  Point variance;
+  Matrix meanGradient;
+  Matrix varianceGradient;
+  SymmetricTensor meanHessian;
+  SymmetricTensor varianceHessian;
+  computeDerivativeMoments(inP, 2, mean, variance, meanGradient, varianceGradient, meanHessian, varianceHessian);
+  if (hasSignificantSupport())
+  {
+    const Scalar weightSum = getSignificantWeightSum();
+    for (UnsignedInteger j = 0; j < meanHessian.getNbSheets(); ++ j)
+      for (UnsignedInteger a = 0; a < meanHessian.getNbRows(); ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          meanHessian(a, b, j) *= weightSum;
+  }
+  return meanHessian;
+}
+
+/* Sum of the weights of the significant support */
+Scalar MeanMeasure::getSignificantWeightSum() const
+{
+  const Point & weights(getSignificantWeights());
+  Scalar weightSum = 0.0;
+  for (UnsignedInteger k = 0; k < weights.getSize(); ++ k)
+    if (weights[k] > 0.0) weightSum += weights[k];
+  return weightSum;
+}
 
+/* Reduction of the function values over the retained discrete support */
+Point MeanMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  const UnsignedInteger outputDimension = values.getDimension();
+  Point outP(outputDimension);
+  for (UnsignedInteger i = 0; i < weights.getSize(); ++i)
+    for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      outP[j] += values(i, j) * weights[i];
+  return outP;
+}
+
+/* With the control variate the mean is \sum_i w_i f_i - c (\sum_i w_i g_i - \mathbb{E}(g)) where g is the
+   first-order Taylor expansion of f with respect to the parameters, whose mean is known exactly */
+Point MeanMeasure::computeDiscreteMeasure(const Point & inP,
+    const Sample & values,
+    const Point & weights) const
+{
+  Point outP(computeDiscreteMeasure(values, weights));
+  if (!controlVariate_) return outP;
+  Sample expansion;
+  Point expansionMean;
+  Point expansionVariance;
+  computeTaylorExpansion(inP, expansion, expansionMean, expansionVariance);
+  Point coefficient;
+  Point controlVariance;
+  Point reduction;
+  ComputeControlVariate(values, expansion, weights, coefficient, controlVariance, reduction);
+  const Point expansionEstimate(computeDiscreteMeasure(expansion, weights));
+  for (UnsignedInteger j = 0; j < outP.getDimension(); ++ j)
+    outP[j] -= coefficient[j] * (expansionEstimate[j] - expansionMean[j]);
+  setLastVarianceReduction(reduction);
+  return outP;
+}
+
+/* Taylor control variate accessor */
+void MeanMeasure::setControlVariate(const Bool controlVariate)
+{
+  controlVariate_ = controlVariate;
+}
+
+Bool MeanMeasure::getControlVariate() const
+{
+  return controlVariate_;
+}
 
 /* String converter */
 String MeanMeasure::__repr__() const
@@ -183,12 +269,15 @@ String MeanMeasure::__repr__() const
 void MeanMeasure::save(Advocate & adv) const
 {
   MeasureEvaluationImplementation::save(adv);
+  adv.saveAttribute("controlVariate_", controlVariate_);
 }
 
 /* Method load() reloads the object from the StorageManager */
 void MeanMeasure::load(Advocate & adv)
 {
   MeasureEvaluationImplementation::load(adv);
+  if (adv.hasAttribute("controlVariate_"))
+    adv.loadAttribute("controlVariate_", controlVariate_);
 }
 
 
@@ -23,13 +23,6 @@
 #include <openturns/GaussKronrod.hxx>
 #include <openturns/IteratedQuadrature.hxx>
 
-#if OPENTURNS_VERSION >= 102700
-#include <openturns/FiniteDiscreteDistribution.hxx>
-#else
-#include <openturns/UserDefined.hxx>
-#define FiniteDiscreteDistribution UserDefined
-#endif
-
 using namespace OT;
 
 namespace OTROBOPT
@@ -47,7 +40,7 @@ MeanStandardDeviationTradeoffMeasure::MeanStandardDeviationTradeoffMeasure()
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("MeanStandardDeviationTradeoffMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Parameter constructor */
@@ -60,7 +53,7 @@ MeanStandardDeviationTradeoffMeasure::MeanStandardDeviationTradeoffMeasure (cons
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("MeanStandardDeviationTradeoffMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Virtual constructor method */
@@ -176,46 +169,74 @@ Point MeanStandardDeviationTradeoffMeasure::operator()(const Point & inP) const
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
-  if (getDistribution().isContinuous())
+  if (!hasSignificantSupport())
   {
     Pointer<FunctionImplementation> p_wrapper(new MeanStandardDeviationTradeoffMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_));
     const Function G(p_wrapper);
     // integrate (f_1(x), ...., f_d(x), f_1^2(x), ..., f_d^2(x))
-    const Point integral(integrationAlgorithm_.integrate(G, getDistribution().getRange()));
+    Point error;
+    const Point integral(computeIntegral(G, error));
+    // The error is propagated if it is known
+    Point outError(error.getDimension() > 0 ? outputDimension : 0);
     for (UnsignedInteger j = 0; j < outputDimension; ++ j)
     {
       const Scalar mean = integral[j];
       // Var(f(x))=\mathbb{E}(f^2(x))-\mathbb{E}(f(x))^2
       const Scalar variance = integral[outputDimension + j] - mean * mean;
       outP[j] = (1.0 - alpha_[j]) * mean + alpha_[j] * sqrt(variance);
+      if (outError.getDimension() == 0) continue;
+      // First order propagation, the square root is not differentiable at a null variance
+      const Scalar varianceError = error[outputDimension + j] + 2.0 * std::abs(mean) * error[j];
+      const Scalar sigmaError = (variance > varianceError ? 0.5 * varianceError / std::sqrt(variance) : std::sqrt(varianceError));
+      outError[j] = (1.0 - alpha_[j]) * error[j] + alpha_[j] * sigmaError;
     }
+    setLastError(outError);
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    Sample values(0, outputDimension);
-    Point weights(0);
-    for (UnsignedInteger i = 0; i < size; ++i)
+    outP = reduce(inP, evaluateSignificantSupport(inP));
+  } // discrete
+  return outP;
+}
+
+/* Gradient: (1-\alpha)\nabla_x\mathbb{E}(f) + \alpha\nabla_x Var(f) / (2\sigma(f)) */
+Matrix MeanStandardDeviationTradeoffMeasure::gradient(const Point & inP) const
+{
+  Point mean;
+  Point variance;
+  Matrix meanGradient;
+  Matrix varianceGradient;
+  SymmetricTensor meanHessian;
+  SymmetricTensor varianceHessian;
+  computeDerivativeMoments(inP, 1, mean, variance, meanGradient, varianceGradient, meanHessian, varianceHessian);
+  const UnsignedInteger inputDimension = meanGradient.getNbRows();
+  const UnsignedInteger outputDimension = meanGradient.getNbColumns();
+  Matrix result(inputDimension, outputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+  {
+    // The standard deviation is not differentiable at zero, its contribution is dropped
+    const Scalar sigma = variance[j] > 0.0 ? sqrt(variance[j]) : 0.0;
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
     {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-          weights.add(pdfs[i]);
-        }
-    } // for
+      result(i, j) = (1.0 - alpha_[j]) * meanGradient(i, j);
+      if (sigma > 0.0) result(i, j) += alpha_[j] * varianceGradient(i, j) / (2.0 * sigma);
+    }
+  }
+  return result;
+}
 
-    // Here we use a FiniteDiscreteDistribution distribution because the algorithm
-    // to compute a central moment is quite involved in the case of
-    // nonuniform weights
-    const FiniteDiscreteDistribution discrete(values, weights);
-    const Point mean(discrete.getMean());
-    const Point standardDeviation(discrete.getStandardDeviation());
-    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
-      outP[j] = (1.0 - alpha_[j]) * mean[j] + alpha_[j] * standardDeviation[j];
-  } // discrete
+/* Reduction of the function values over the retained discrete support */
+Point MeanStandardDeviationTradeoffMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  // Single pass weighted moments, no need to build a discrete distribution
+  Point mean;
+  Point variance;
+  ComputeWeightedMoments(values, weights, mean, variance);
+  const UnsignedInteger outputDimension = values.getDimension();
+  Point outP(outputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    outP[j] = (1.0 - alpha_[j]) * mean[j] + alpha_[j] * sqrt(variance[j]);
   return outP;
 }
 
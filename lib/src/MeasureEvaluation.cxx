@@ -36,13 +36,45 @@ struct MeasureEvaluation_init
     ResourceMap::AddAsScalar("SequentialMonteCarloRobustAlgorithm-ConvergenceFactor", 1e-2);
     ResourceMap::AddAsUnsignedInteger("SequentialMonteCarloRobustAlgorithm-DefaultInitialSamplingSize", 10);
 
+    ResourceMap::AddAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultInitialMaximumError", 1e-3);
+    ResourceMap::AddAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultFinalMaximumError", 1e-10);
+    ResourceMap::AddAsScalar("AdaptiveIntegrationRobustAlgorithm-DefaultErrorReductionFactor", 1e-2);
+
+    ResourceMap::AddAsUnsignedInteger("MeasureEvaluation-BlockSize", 256);
+    ResourceMap::AddAsUnsignedInteger("MeasureEvaluation-CacheSize", 8);
+    ResourceMap::AddAsScalar("MeasureEvaluation-ImportanceSamplingQuantileLevel", 0.1);
+    ResourceMap::AddAsUnsignedInteger("MeasureEvaluation-ImportanceSamplingMaximumLevelsNumber", 20);
+
+    ResourceMap::AddAsUnsignedInteger("QuasiMonteCarloIntegration-DefaultSize", 1024);
+    ResourceMap::AddAsUnsignedInteger("QuasiMonteCarloIntegration-DefaultReplicationsNumber", 8);
+    ResourceMap::AddAsScalar("SparseGridIntegration-DefaultMaximumError", 1e-8);
+    ResourceMap::AddAsUnsignedInteger("SparseGridIntegration-DefaultMaximumCallsNumber", 100000);
+    ResourceMap::AddAsUnsignedInteger("SparseGridIntegration-DefaultMaximumLevel", 10);
+
     ResourceMap::AddAsUnsignedInteger("MeanMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
+    ResourceMap::AddAsBool("MeanMeasure-ControlVariate", false);
     ResourceMap::AddAsUnsignedInteger("VarianceMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
+    ResourceMap::AddAsBool("VarianceMeasure-ControlVariate", false);
     ResourceMap::AddAsUnsignedInteger("MeanStandardDeviationTradeoffMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
     ResourceMap::AddAsUnsignedInteger("QuantileMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
+    ResourceMap::AddAsScalar("QuantileMeasure-RelativeBandwidth", 0.05);
+    ResourceMap::AddAsBool("QuantileMeasure-SingleSweep", false);
+    ResourceMap::AddAsScalar("QuantileMeasure-BracketProbabilityStep", 0.05);
+    ResourceMap::AddAsUnsignedInteger("QuantileMeasure-SingleSweepNodesNumber", 4096);
 
     ResourceMap::AddAsUnsignedInteger("IndividualChanceMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
     ResourceMap::AddAsUnsignedInteger("JointChanceMeasure-GaussKronrodRule", GaussKronrodRule::G7K15);
+    ResourceMap::AddAsScalar("IndividualChanceMeasure-SmoothingBandwidth", 0.0);
+    ResourceMap::AddAsScalar("JointChanceMeasure-SmoothingBandwidth", 0.0);
+    ResourceMap::AddAsScalar("IndividualChanceMeasure-FinalSmoothingBandwidth", 0.0);
+    ResourceMap::AddAsScalar("JointChanceMeasure-FinalSmoothingBandwidth", 0.0);
+    ResourceMap::AddAsScalar("IndividualChanceMeasure-SmoothingBandwidthReductionFactor", 0.1);
+    ResourceMap::AddAsScalar("JointChanceMeasure-SmoothingBandwidthReductionFactor", 0.1);
+    ResourceMap::AddAsUnsignedInteger("IndividualChanceMeasure-ImportanceSamplingSize", 0);
+    ResourceMap::AddAsUnsignedInteger("JointChanceMeasure-ImportanceSamplingSize", 0);
+
+    ResourceMap::AddAsUnsignedInteger("WorstCaseMeasure-StartingPointsNumber", 1);
+    ResourceMap::AddAsUnsignedInteger("WorstCaseMeasure-WarmStartCacheSize", 0);
   }
 };
 
@@ -70,6 +102,66 @@ Point MeasureEvaluation::operator()(const Point & inP) const
   return getImplementation()->operator()(inP);
 }
 
+Sample MeasureEvaluation::operator()(const Sample & inS) const
+{
+  return getImplementation()->operator()(inS);
+}
+
+/* Gradient */
+Matrix MeasureEvaluation::gradient(const Point & inP) const
+{
+  return getImplementation()->gradient(inP);
+}
+
+/* Hessian */
+SymmetricTensor MeasureEvaluation::hessian(const Point & inP) const
+{
+  return getImplementation()->hessian(inP);
+}
+
+/* Requested accuracy of the integration over a continuous distribution */
+void MeasureEvaluation::setMaximumError(const Scalar maximumError)
+{
+  copyOnWrite();
+  getImplementation()->setMaximumError(maximumError);
+}
+
+Scalar MeasureEvaluation::getMaximumError() const
+{
+  return getImplementation()->getMaximumError();
+}
+
+/* Error estimate of the last evaluation over a continuous distribution */
+Point MeasureEvaluation::getLastError() const
+{
+  return getImplementation()->getLastError();
+}
+
+/* Next step of the smoothing bandwidth schedule */
+Bool MeasureEvaluation::reduceSmoothingBandwidth()
+{
+  copyOnWrite();
+  return getImplementation()->reduceSmoothingBandwidth();
+}
+
+/* Variance reduction of the control variate at the last evaluation */
+Point MeasureEvaluation::getLastVarianceReduction() const
+{
+  return getImplementation()->getLastVarianceReduction();
+}
+
+/* Cache of the function values shared with other measures */
+void MeasureEvaluation::setEvaluationCache(const MeasureEvaluationCache & cache)
+{
+  copyOnWrite();
+  getImplementation()->setEvaluationCache(cache);
+}
+
+MeasureEvaluationCache MeasureEvaluation::getEvaluationCache() const
+{
+  return getImplementation()->getEvaluationCache();
+}
+
 /* Distribution accessor */
 void MeasureEvaluation::setDistribution(const Distribution & distribution)
 {
@@ -0,0 +1,192 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Cache of the function values shared by measures
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/MeasureEvaluationCache.hxx"
+#include "otrobopt/MeasureEvaluation.hxx"
+#include "otrobopt/MeasureEvaluationImplementation.hxx"
+#include <openturns/ResourceMap.hxx>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+/* Default constructor */
+MeasureEvaluationCache::MeasureEvaluationCache()
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+MeasureEvaluationCache::MeasureEvaluationCache(const UnsignedInteger supportSize,
+    const UnsignedInteger maximumSize)
+  : p_storage_(new Storage)
+{
+  p_storage_->supportSize_ = supportSize;
+  p_storage_->maximumSize_ = maximumSize;
+}
+
+/* Whether the cache is enabled */
+Bool MeasureEvaluationCache::isEnabled() const
+{
+  return p_storage_.get() != 0;
+}
+
+/* Copy the known values at x on the given nodes, return the positions of the missing ones */
+Indices MeasureEvaluationCache::find(const Point & x,
+                                     const Indices & nodes,
+                                     Sample & values) const
+{
+  const UnsignedInteger size = nodes.getSize();
+  Indices missing(0);
+  if (!isEnabled())
+  {
+    missing = Indices(size);
+    missing.fill();
+    return missing;
+  }
+  std::lock_guard<std::mutex> lock(p_storage_->mutex_);
+  const Collection<Point> & points = p_storage_->points_;
+  UnsignedInteger index = 0;
+  while ((index < points.getSize()) && (points[index] != x)) ++ index;
+  if (index == points.getSize())
+  {
+    missing = Indices(size);
+    missing.fill();
+    return missing;
+  }
+  const Sample & cached = p_storage_->values_[index];
+  const Indices & known = p_storage_->known_[index];
+  for (UnsignedInteger k = 0; k < size; ++ k)
+  {
+    if (known[nodes[k]]) values[k] = cached[nodes[k]];
+    else missing.add(k);
+  }
+  return missing;
+}
+
+/* Store the values at x on the given nodes */
+void MeasureEvaluationCache::add(const Point & x,
+                                 const Indices & nodes,
+                                 const Sample & values)
+{
+  if (!isEnabled() || (p_storage_->maximumSize_ == 0)) return;
+  std::lock_guard<std::mutex> lock(p_storage_->mutex_);
+  const UnsignedInteger index = locate(x);
+  Sample & cached = p_storage_->values_[index];
+  if (cached.getSize() != p_storage_->supportSize_)
+    cached = Sample(p_storage_->supportSize_, values.getDimension());
+  Indices & known = p_storage_->known_[index];
+  for (UnsignedInteger k = 0; k < nodes.getSize(); ++ k)
+  {
+    cached[nodes[k]] = values[k];
+    known[nodes[k]] = 1;
+  }
+}
+
+/* Copy the gradient at x on the given node if it is known */
+Bool MeasureEvaluationCache::findGradient(const Point & x,
+    const UnsignedInteger node,
+    Matrix & gradient) const
+{
+  if (!isEnabled()) return false;
+  std::lock_guard<std::mutex> lock(p_storage_->mutex_);
+  const Collection<Point> & points = p_storage_->points_;
+  UnsignedInteger index = 0;
+  while ((index < points.getSize()) && (points[index] != x)) ++ index;
+  if ((index == points.getSize()) || !p_storage_->knownGradients_[index][node]) return false;
+  gradient = p_storage_->gradients_[index][node];
+  return true;
+}
+
+/* Store the gradient at x on the given node */
+void MeasureEvaluationCache::addGradient(const Point & x,
+    const UnsignedInteger node,
+    const Matrix & gradient)
+{
+  if (!isEnabled() || (p_storage_->maximumSize_ == 0)) return;
+  std::lock_guard<std::mutex> lock(p_storage_->mutex_);
+  const UnsignedInteger index = locate(x);
+  p_storage_->gradients_[index][node] = gradient;
+  p_storage_->knownGradients_[index][node] = 1;
+}
+
+/* Slot of x in the storage, created when missing */
+UnsignedInteger MeasureEvaluationCache::locate(const Point & x)
+{
+  Storage & storage = *p_storage_;
+  UnsignedInteger index = 0;
+  while ((index < storage.points_.getSize()) && (storage.points_[index] != x)) ++ index;
+  if (index < storage.points_.getSize()) return index;
+  // The values are sized by the first add() as their dimension is not known yet
+  const Indices unknown(storage.supportSize_, 0);
+  const Collection<Matrix> gradients(storage.supportSize_);
+  if (storage.points_.getSize() < storage.maximumSize_)
+  {
+    storage.points_.add(x);
+    storage.values_.add(Sample());
+    storage.known_.add(unknown);
+    storage.gradients_.add(gradients);
+    storage.knownGradients_.add(unknown);
+  }
+  else
+  {
+    // Replace the oldest point
+    index = storage.next_ % storage.maximumSize_;
+    storage.points_[index] = x;
+    storage.values_[index] = Sample();
+    storage.known_[index] = unknown;
+    storage.gradients_[index] = gradients;
+    storage.knownGradients_[index] = unknown;
+    storage.next_ = index + 1;
+  }
+  return index;
+}
+
+/* Attach a common cache to the measures of the same function reduced over the same nodes,
+   the support of a discrete distribution or the nodes of a fixed integration rule */
+void MeasureEvaluationCache::Share(Collection<MeasureEvaluation> & measures)
+{
+  const UnsignedInteger size = measures.getSize();
+  const UnsignedInteger maximumSize = ResourceMap::GetAsUnsignedInteger("MeasureEvaluation-CacheSize");
+  Indices shared(size, 0);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    if (shared[i]) continue;
+    const MeasureEvaluationImplementation & measure = *measures[i].getImplementation();
+    // The measures integrated adaptively evaluate the function on nodes depending on x
+    if (measure.getNodesNumber() == 0) continue;
+    const Function function(measure.getFunction());
+    Indices group(1, i);
+    for (UnsignedInteger k = i + 1; k < size; ++ k)
+      if (!shared[k] && (measures[k].getFunction().getImplementation() == function.getImplementation()) && measure.hasSameNodes(*measures[k].getImplementation()))
+        group.add(k);
+    // A single measure gains nothing from the cache
+    if (group.getSize() < 2) continue;
+    const MeasureEvaluationCache cache(measure.getNodesNumber(), maximumSize);
+    for (UnsignedInteger k = 0; k < group.getSize(); ++ k)
+    {
+      measures[group[k]].setEvaluationCache(cache);
+      shared[group[k]] = 1;
+    }
+  }
+}
+
+} /* namespace OTROBOPT */
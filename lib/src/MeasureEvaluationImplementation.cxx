@@ -19,8 +19,23 @@
  *
  */
 #include "otrobopt/MeasureEvaluationImplementation.hxx"
+#include "otrobopt/QuasiMonteCarloIntegration.hxx"
+#include "otrobopt/SparseGridIntegration.hxx"
 #include <openturns/PersistentObjectFactory.hxx>
 #include <openturns/IteratedQuadrature.hxx>
+#include <openturns/GaussKronrod.hxx>
+#include <openturns/GaussLegendre.hxx>
+#include <openturns/ParametricEvaluation.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <openturns/ResourceMap.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <openturns/DistFunc.hxx>
+#include <openturns/CenteredFiniteDifferenceGradient.hxx>
+#include <openturns/CenteredFiniteDifferenceHessian.hxx>
+#include <openturns/Normal.hxx>
+
+#include <algorithm>
+#include <vector>
 
 using namespace OT;
 
@@ -31,11 +46,15 @@ CLASSNAMEINIT(MeasureEvaluationImplementation)
 
 static Factory<MeasureEvaluationImplementation> Factory_MeasureEvaluationImplementation;
 
+// exp(-0.5 * 8^2) is below the double precision relative to the kernel mode
+const Scalar MeasureEvaluationImplementation::KernelSupport = 8.0;
+
 
 /* Default constructor */
 MeasureEvaluationImplementation::MeasureEvaluationImplementation()
   : EvaluationImplementation()
   , pdfThreshold_(SpecFunc::Precision)
+  , maximumError_(ResourceMap::GetAsScalar("GaussKronrod-MaximumError"))
 {
   // Nothing to do
 }
@@ -47,12 +66,15 @@ MeasureEvaluationImplementation::MeasureEvaluationImplementation (const Function
   , distribution_(distribution)
   , integrationAlgorithm_(IteratedQuadrature())
   , pdfThreshold_(SpecFunc::Precision)
+  , maximumError_(ResourceMap::GetAsScalar("GaussKronrod-MaximumError"))
+  , referenceDistribution_(distribution)
 {
   if (distribution.getDimension() != function.getParameter().getDimension())
     throw InvalidDimensionException(HERE) << "Function parameter dimension (" << function.getParameter().getDimension()
                                           << ") must match the distribution dimension (" << distribution.getDimension() << ")";
   setInputDescription(function_.getInputDescription());
   setOutputDescription(function_.getOutputDescription());
+  updateSignificantSupport();
 }
 
 
@@ -69,6 +91,1065 @@ Point MeasureEvaluationImplementation::operator()(const Point & /*inP*/) const
   throw NotYetImplementedException(HERE) << "MeasureEvaluationImplementation::operator()(const Point & inP)";
 }
 
+Sample MeasureEvaluationImplementation::operator()(const Sample & inS) const
+{
+  const UnsignedInteger size = inS.getSize();
+  if (inS.getDimension() != getInputDimension())
+    throw InvalidArgumentException(HERE) << "Error: expected a sample of dimension " << getInputDimension() << ", got " << inS.getDimension();
+  // The continuous measures are integrated point by point
+  if (!hasSignificantSupport()) return EvaluationImplementation::operator()(inS);
+  // The retained support is shared by all the design points,
+  // and the whole grid of (x, theta) values is evaluated as one batch
+  const Sample values(evaluateSignificantSupport(inS));
+  const UnsignedInteger supportSize = significantSupport_.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  Sample outS(size, getOutputDimension());
+  Sample valuesI(supportSize, dimension);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    for (UnsignedInteger k = 0; k < supportSize; ++ k)
+      for (UnsignedInteger j = 0; j < dimension; ++ j)
+        valuesI(k, j) = values(i * supportSize + k, j);
+    outS[i] = reduce(inS[i], valuesI);
+  }
+  return outS;
+}
+
+
+/* Gradient */
+Matrix MeasureEvaluationImplementation::gradient(const Point & inP) const
+{
+  const CenteredFiniteDifferenceGradient fdGradient(ResourceMap::GetAsScalar("CenteredFiniteDifferenceGradient-DefaultEpsilon"), Evaluation(*this));
+  return fdGradient.gradient(inP);
+}
+
+/* Hessian */
+SymmetricTensor MeasureEvaluationImplementation::hessian(const Point & inP) const
+{
+  const CenteredFiniteDifferenceHessian fdHessian(ResourceMap::GetAsScalar("CenteredFiniteDifferenceHessian-DefaultEpsilon"), Evaluation(*this));
+  return fdHessian.hessian(inP);
+}
+
+
+/* Reduction of the function values over the retained discrete support */
+Point MeasureEvaluationImplementation::computeDiscreteMeasure(const Sample & /*values*/,
+    const Point & /*weights*/) const
+{
+  throw NotYetImplementedException(HERE) << "MeasureEvaluationImplementation::computeDiscreteMeasure(const Sample & values, const Point & weights)";
+}
+
+Point MeasureEvaluationImplementation::computeDiscreteMeasure(const Point & /*inP*/,
+    const Sample & values,
+    const Point & weights) const
+{
+  return computeDiscreteMeasure(values, weights);
+}
+
+/* Value of the measure at x from the values of the function on the significant support */
+Point MeasureEvaluationImplementation::reduce(const Point & inP,
+    const Sample & values) const
+{
+  const Point outP(computeDiscreteMeasure(inP, values, significantWeights_));
+  // The replications of the quasi-Monte Carlo nodes estimate the error of the measure
+  if (replicationsNumber_ > 1) setLastError(computeReplicationsError(values));
+  return outP;
+}
+
+/* Each replication reduced alone, with its weights scaled by the number of replications,
+   is an independent estimate of the measure as in QuasiMonteCarloIntegration::integrate */
+Point MeasureEvaluationImplementation::computeReplicationsError(const Sample & values) const
+{
+  const UnsignedInteger size = significantIndices_.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  Sample estimates(0, getOutputDimension());
+  UnsignedInteger first = 0;
+  for (UnsignedInteger r = 0; r < replicationsNumber_; ++ r)
+  {
+    // The significant nodes keep their order, so each replication is a contiguous block
+    UnsignedInteger last = first;
+    while ((last < size) && (significantIndices_[last] / replicationSize_ == r)) ++ last;
+    if (last == first) continue;
+    Sample blockValues(last - first, dimension);
+    Point blockWeights(last - first);
+    for (UnsignedInteger k = first; k < last; ++ k)
+    {
+      blockValues[k - first] = values[k];
+      blockWeights[k - first] = replicationsNumber_ * significantWeights_[k];
+    }
+    estimates.add(computeDiscreteMeasure(blockValues, blockWeights));
+    first = last;
+  }
+  if (estimates.getSize() < 2) return Point();
+  const Point variance(estimates.computeVariance());
+  Point error(variance.getDimension());
+  for (UnsignedInteger j = 0; j < error.getDimension(); ++ j)
+    error[j] = std::sqrt(variance[j] / estimates.getSize());
+  return error;
+}
+
+
+/* Significant nodes of a discrete distribution or a fixed rule and their weights.
+   They only depend on the distribution, the algorithm and the threshold, they are
+   computed by their accessors and handed out by reference */
+const Sample & MeasureEvaluationImplementation::getSignificantSupport() const
+{
+  return significantSupport_;
+}
+
+const Point & MeasureEvaluationImplementation::getSignificantWeights() const
+{
+  return significantWeights_;
+}
+
+/* Whether the values of the function are reduced over a fixed support */
+Bool MeasureEvaluationImplementation::hasSignificantSupport() const
+{
+  return !distribution_.isContinuous() || hasIntegrationNodes_;
+}
+
+void MeasureEvaluationImplementation::updateSignificantSupport()
+{
+  significantSupport_ = Sample();
+  significantWeights_ = Point();
+  significantIndices_ = Indices();
+  hasIntegrationNodes_ = false;
+  replicationsNumber_ = 0;
+  replicationSize_ = 0;
+  nodesNumber_ = 0;
+  Sample parameters;
+  Point pdfs;
+  if (!distribution_.isContinuous())
+  {
+    pdfs = distribution_.getProbabilities();
+    parameters = distribution_.getSupport();
+  }
+  else
+  {
+    // The nodes of a fixed rule do not depend on x, nor their probabilities
+    const Interval range(distribution_.getRange());
+    if (ComputeRuleNodes(integrationAlgorithm_, range, parameters, pdfs))
+    {
+      if (const QuasiMonteCarloIntegration * p_qmc = dynamic_cast<const QuasiMonteCarloIntegration *>(integrationAlgorithm_.getImplementation().get()))
+      {
+        replicationsNumber_ = p_qmc->getReplicationsNumber();
+        replicationSize_ = parameters.getSize() / replicationsNumber_;
+      }
+    }
+    else
+    {
+      if (sweepNodesNumber_ == 0) return;
+      // The nodes of an adaptive rule are not known beforehand, it is replaced by a tensorized
+      // Gauss-Legendre rule with as many nodes per axis as the requested number allows.
+      // There are at least 2 nodes per axis, so 2^d nodes beyond dimension log2(number)
+      const UnsignedInteger dimension = range.getDimension();
+      UnsignedInteger nodesNumber = static_cast<UnsignedInteger>(std::round(std::pow(1.0 * sweepNodesNumber_, 1.0 / dimension)));
+      while ((nodesNumber > 2) && (std::pow(1.0 * nodesNumber, 1.0 * dimension) > sweepNodesNumber_)) -- nodesNumber;
+      ComputeRuleNodes(GaussLegendre(Indices(dimension, std::max<UnsignedInteger>(2, nodesNumber))), range, parameters, pdfs);
+    }
+    const Point nodesPDF(ComputeNodesPDF(distribution_, parameters));
+    for (UnsignedInteger i = 0; i < parameters.getSize(); ++i)
+      pdfs[i] = (nodesPDF[i] > pdfThreshold_ ? pdfs[i] * nodesPDF[i] : 0.0);
+    hasIntegrationNodes_ = true;
+  }
+  // The nodes have already been thresholded on their PDF, their mass is only checked to be positive
+  const Scalar threshold = (hasIntegrationNodes_ ? 0.0 : pdfThreshold_);
+  const UnsignedInteger size = parameters.getSize();
+  nodesNumber_ = size;
+  Indices significant(0);
+  for (UnsignedInteger i = 0; i < size; ++i)
+    if (pdfs[i] > threshold) significant.add(i);
+  significantSupport_ = parameters.select(significant);
+  significantWeights_ = Point(significant.getSize());
+  for (UnsignedInteger i = 0; i < significant.getSize(); ++i)
+    significantWeights_[i] = pdfs[significant[i]];
+  significantIndices_ = significant;
+}
+
+/* Number of nodes replacing an adaptive rule over a continuous distribution, 0 for none */
+void MeasureEvaluationImplementation::setSweepNodesNumber(const UnsignedInteger sweepNodesNumber)
+{
+  sweepNodesNumber_ = sweepNodesNumber;
+  // The support of a discrete distribution and its shared values do not depend on it
+  if (!distribution_.isContinuous()) return;
+  updateSignificantSupport();
+  evaluationCache_ = MeasureEvaluationCache();
+}
+
+/* Nodes of a fixed integration rule over an interval and their weights, false for an adaptive rule */
+Bool MeasureEvaluationImplementation::ComputeRuleNodes(const IntegrationAlgorithm & algorithm,
+    const Interval & interval,
+    Sample & nodes,
+    Point & weights)
+{
+  const IntegrationAlgorithmImplementation * p_algorithm = algorithm.getImplementation().get();
+  if (const QuasiMonteCarloIntegration * p_qmc = dynamic_cast<const QuasiMonteCarloIntegration *>(p_algorithm))
+  {
+    nodes = p_qmc->generateWithWeights(interval, weights);
+    return true;
+  }
+  const GaussLegendre * p_gaussLegendre = dynamic_cast<const GaussLegendre *>(p_algorithm);
+  if (!p_gaussLegendre) return false;
+  // The rule is defined over the unit cube
+  const UnsignedInteger dimension = interval.getDimension();
+  const Point lowerBound(interval.getLowerBound());
+  const Point delta(interval.getUpperBound() - lowerBound);
+  nodes = p_gaussLegendre->getNodes();
+  weights = p_gaussLegendre->getWeights();
+  if (nodes.getDimension() != dimension)
+    throw InvalidArgumentException(HERE) << "Error: the dimension of the Gauss-Legendre rule (" << nodes.getDimension() << ") does not match the interval dimension (" << dimension << ")";
+  Scalar volume = 1.0;
+  for (UnsignedInteger j = 0; j < dimension; ++ j)
+    volume *= delta[j];
+  for (UnsignedInteger i = 0; i < nodes.getSize(); ++ i)
+  {
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      nodes(i, j) = lowerBound[j] + delta[j] * nodes(i, j);
+    weights[i] *= volume;
+  }
+  return true;
+}
+
+/* PDF of a distribution at the nodes */
+Point MeasureEvaluationImplementation::ComputeNodesPDF(const Distribution & distribution,
+    const Sample & nodes)
+{
+  const UnsignedInteger size = nodes.getSize();
+  const UnsignedInteger dimension = nodes.getDimension();
+  if ((dimension == 1) || !distribution.hasIndependentCopula()) return distribution.computePDF(nodes).asPoint();
+  // Product of the marginal PDFs, computed once per distinct coordinate
+  // as a tensorized rule only has a few of them along each axis
+  Point pdf(size, 1.0);
+  for (UnsignedInteger j = 0; j < dimension; ++ j)
+  {
+    std::vector<Scalar> coordinates(size);
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      coordinates[i] = nodes(i, j);
+    std::sort(coordinates.begin(), coordinates.end());
+    coordinates.erase(std::unique(coordinates.begin(), coordinates.end()), coordinates.end());
+    Sample distinct(coordinates.size(), 1);
+    for (UnsignedInteger k = 0; k < coordinates.size(); ++ k)
+      distinct(k, 0) = coordinates[k];
+    const Point marginalPDF(distribution.getMarginal(j).computePDF(distinct).asPoint());
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      pdf[i] *= marginalPDF[std::lower_bound(coordinates.begin(), coordinates.end(), nodes(i, j)) - coordinates.begin()];
+  }
+  return pdf;
+}
+
+
+/* Evaluation of contiguous blocks of support nodes, possibly in parallel.
+   Each block writes into its own rows of the output, so the values do not
+   depend on the scheduling and the reductions done afterwards by the measures
+   in the node order give the same result as a serial evaluation.
+   The value at the i-th design point and the k-th node is stored in row i * N + k,
+   where N is the support size */
+struct MeasureEvaluationParametricPolicy
+{
+  const Sample & x_;
+  const Sample & parameters_;
+  const Function & function_;
+  const Indices & inputPositions_;
+  const Indices & parametersPositions_;
+  const Bool isParametric_;
+  const UnsignedInteger blockSize_;
+  Sample & output_;
+
+  MeasureEvaluationParametricPolicy(const Sample & x,
+                                    const Sample & parameters,
+                                    const Function & function,
+                                    const Indices & inputPositions,
+                                    const Indices & parametersPositions,
+                                    const Bool isParametric,
+                                    const UnsignedInteger blockSize,
+                                    Sample & output)
+    : x_(x)
+    , parameters_(parameters)
+    , function_(function)
+    , inputPositions_(inputPositions)
+    , parametersPositions_(parametersPositions)
+    , isParametric_(isParametric)
+    , blockSize_(blockSize)
+    , output_(output)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger size = parameters_.getSize();
+    const UnsignedInteger xSize = x_.getSize();
+    const UnsignedInteger outputDimension = output_.getDimension();
+    for (UnsignedInteger b = r.begin(); b != r.end(); ++ b)
+    {
+      const UnsignedInteger first = b * blockSize_;
+      const UnsignedInteger last = std::min(first + blockSize_, size);
+      const UnsignedInteger blockSize = last - first;
+      if (isParametric_)
+      {
+        // Build the (x, theta) sample of the underlying function
+        const UnsignedInteger inputDimension = inputPositions_.getSize();
+        const UnsignedInteger parameterDimension = parametersPositions_.getSize();
+        Sample fullInput(xSize * blockSize, inputDimension + parameterDimension);
+        for (UnsignedInteger i = 0; i < xSize; ++ i)
+          for (UnsignedInteger k = first; k < last; ++ k)
+          {
+            const UnsignedInteger row = i * blockSize + k - first;
+            for (UnsignedInteger j = 0; j < inputDimension; ++ j)
+              fullInput(row, inputPositions_[j]) = x_(i, j);
+            for (UnsignedInteger j = 0; j < parameterDimension; ++ j)
+              fullInput(row, parametersPositions_[j]) = parameters_(k, j);
+          }
+        const Sample values(function_(fullInput));
+        for (UnsignedInteger i = 0; i < xSize; ++ i)
+          for (UnsignedInteger k = first; k < last; ++ k)
+            for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+              output_(i * size + k, j) = values(i * blockSize + k - first, j);
+      }
+      else
+      {
+        // Generic function: swap the parameter node after node on a local copy
+        // and evaluate all the design points at once
+        Function function(function_);
+        for (UnsignedInteger k = first; k < last; ++ k)
+        {
+          function.setParameter(parameters_[k]);
+          const Sample values(function(x_));
+          for (UnsignedInteger i = 0; i < xSize; ++ i)
+            output_[i * size + k] = values[i];
+        }
+      }
+    } // b
+  }
+}; /* end struct MeasureEvaluationParametricPolicy */
+
+
+/* Evaluate the function at x for each parameter value of the sample */
+Sample MeasureEvaluationImplementation::evaluateParametric(const Point & inP,
+    const Sample & parameters) const
+{
+  return evaluateParametric(Sample(1, inP), parameters);
+}
+
+/* Probability that the given marginals are all nonnegative, or its complement, by importance sampling.
+   The proposal is a gaussian distribution with independent components, initialized with the mean and
+   standard deviation of the distribution. While less than a fraction rho of the nodes reach the event,
+   its parameters are fitted by cross-entropy to the weighted nodes whose score exceeds the (1 - rho)
+   quantile of the scores. The adapted proposal is kept for the next design points, and the nodes are
+   drawn from a fixed standard sample in order to get an estimate that is smooth with respect to x */
+Scalar MeasureEvaluationImplementation::computeImportanceSampling(const Point & inP,
+    const Indices & marginals,
+    const Bool complement,
+    const Scalar bandwidth,
+    const UnsignedInteger slot,
+    const UnsignedInteger size,
+    Scalar & variance) const
+{
+  if (size == 0) throw InvalidArgumentException(HERE) << "The importance sampling size must be positive";
+  const Distribution distribution(getDistribution());
+  const UnsignedInteger dimension = distribution.getDimension();
+  const Sample standardSample(proposals_.getStandardSample(size, dimension));
+  Point mean;
+  Point sigma;
+  if (!proposals_.find(slot, mean, sigma))
+  {
+    mean = distribution.getMean();
+    sigma = distribution.getStandardDeviation();
+  }
+  const Scalar rho = ResourceMap::GetAsScalar("MeasureEvaluation-ImportanceSamplingQuantileLevel");
+  const UnsignedInteger maximumLevelsNumber = ResourceMap::GetAsUnsignedInteger("MeasureEvaluation-ImportanceSamplingMaximumLevelsNumber");
+  const UnsignedInteger rank = std::min<UnsignedInteger>(size - 1, static_cast<UnsignedInteger>((1.0 - rho) * size));
+  Sample values;
+  Point weights(size);
+  Point scores(size);
+  for (UnsignedInteger level = 0; ; ++ level)
+  {
+    Sample theta(size, dimension);
+    Point logProposal(size, dimension * std::log(SpecFunc::ISQRT2PI));
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      for (UnsignedInteger j = 0; j < dimension; ++ j)
+      {
+        const Scalar z = standardSample(i, j);
+        theta(i, j) = mean[j] + sigma[j] * z;
+        logProposal[i] -= 0.5 * z * z + std::log(sigma[j]);
+      }
+    const Sample logPDF(distribution.computeLogPDF(theta));
+    values = evaluateParametric(inP, theta);
+    for (UnsignedInteger i = 0; i < size; ++ i)
+    {
+      weights[i] = std::exp(logPDF(i, 0) - logProposal[i]);
+      Scalar score = SpecFunc::MaxScalar;
+      for (UnsignedInteger k = 0; k < marginals.getSize(); ++ k)
+        score = std::min(score, values(i, marginals[k]));
+      scores[i] = complement ? -score : score;
+    }
+    // Intermediate level exceeded by a fraction rho of the nodes
+    std::vector<Scalar> sortedScores(scores.begin(), scores.end());
+    std::nth_element(sortedScores.begin(), sortedScores.begin() + rank, sortedScores.end());
+    const Scalar gamma = sortedScores[rank];
+    if ((gamma >= 0.0) || (level + 1 >= maximumLevelsNumber)) break;
+    // Cross-entropy update of the proposal on the nodes above the intermediate level
+    Point eliteMean(dimension);
+    Scalar weightSum = 0.0;
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      if ((scores[i] >= gamma) && (weights[i] > 0.0))
+      {
+        weightSum += weights[i];
+        for (UnsignedInteger j = 0; j < dimension; ++ j)
+          eliteMean[j] += weights[i] * theta(i, j);
+      }
+    if (!(weightSum > 0.0) || !SpecFunc::IsNormal(weightSum)) break;
+    eliteMean /= weightSum;
+    Point eliteSigma(dimension);
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      if ((scores[i] >= gamma) && (weights[i] > 0.0))
+        for (UnsignedInteger j = 0; j < dimension; ++ j)
+          eliteSigma[j] += weights[i] * (theta(i, j) - eliteMean[j]) * (theta(i, j) - eliteMean[j]);
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+    {
+      eliteSigma[j] = std::sqrt(eliteSigma[j] / weightSum);
+      // A degenerate elite set keeps the previous spread
+      if (!(eliteSigma[j] > 0.0)) eliteSigma[j] = sigma[j];
+    }
+    mean = eliteMean;
+    sigma = eliteSigma;
+  }
+  proposals_.set(slot, mean, sigma);
+  // Estimate from the nodes of the last proposal
+  Scalar probability = 0.0;
+  Scalar squareSum = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    Scalar indicator = (scores[i] >= 0.0 ? 1.0 : 0.0);
+    if (bandwidth > 0.0)
+    {
+      indicator = 1.0;
+      for (UnsignedInteger k = 0; k < marginals.getSize(); ++ k)
+        indicator *= DistFunc::pNormal(values(i, marginals[k]) / bandwidth);
+      if (complement) indicator = 1.0 - indicator;
+    }
+    const Scalar term = weights[i] * indicator;
+    probability += term;
+    squareSum += term * term;
+  }
+  probability /= size;
+  variance = std::max(0.0, squareSum / size - probability * probability) / size;
+  return probability;
+}
+
+/* Draw the quasi-Monte Carlo nodes, if any, from the distribution of the measure */
+void MeasureEvaluationImplementation::updateIntegrationAlgorithm()
+{
+  const QuasiMonteCarloIntegration * p_qmc = dynamic_cast<const QuasiMonteCarloIntegration *>(integrationAlgorithm_.getImplementation().get());
+  if (!p_qmc || !distribution_.isContinuous()) return;
+  // The nodes are pushed through the inverse iso-probabilistic transformation
+  // instead of being uniform over the range
+  QuasiMonteCarloIntegration algorithm(*p_qmc);
+  algorithm.setDistribution(distribution_);
+  integrationAlgorithm_ = algorithm;
+}
+
+/* Integral of a kernel over the range of the distribution and its error estimate */
+Point MeasureEvaluationImplementation::computeIntegral(const Function & kernel,
+    Point & error) const
+{
+  const Interval range(getDistribution().getRange());
+  const IntegrationAlgorithmImplementation * p_algorithm = integrationAlgorithm_.getImplementation().get();
+  if (const QuasiMonteCarloIntegration * p_qmc = dynamic_cast<const QuasiMonteCarloIntegration *>(p_algorithm))
+    return p_qmc->integrate(kernel, range, error);
+  if (const SparseGridIntegration * p_sparseGrid = dynamic_cast<const SparseGridIntegration *>(p_algorithm))
+    return p_sparseGrid->integrate(kernel, range, error);
+  Point integral;
+  if (const GaussKronrod * p_gaussKronrod = dynamic_cast<const GaussKronrod *>(p_algorithm))
+  {
+    Scalar scalarError = 0.0;
+    integral = p_gaussKronrod->integrate(kernel, range, scalarError);
+    error = Point(integral.getDimension(), scalarError);
+    return integral;
+  }
+  // In dimension 1 the default iterated quadrature reduces to its inner rule, which estimates its error
+  if (hasIteratedRule_ && (range.getDimension() == 1))
+  {
+    Scalar scalarError = 0.0;
+    integral = iteratedRule_.integrate(kernel, range, scalarError);
+    error = Point(integral.getDimension(), scalarError);
+    return integral;
+  }
+  // The other iterated quadratures do not report their error
+  integral = integrationAlgorithm_.integrate(kernel, range);
+  error = Point();
+  return integral;
+}
+
+/* Store the error estimate of the current evaluation */
+void MeasureEvaluationImplementation::setLastError(const Point & error) const
+{
+  lastError_.set(error);
+}
+
+/* First-order Taylor expansion g(\theta) = f(x, \mu) + \nabla_\theta f(x, \mu)^T (\theta - \mu) on the significant
+   support, where \mu and \Sigma are the mean and covariance of the reference distribution. Its mean is f(x, \mu)
+   and the variance of its j-th marginal is \nabla_\theta f_j^T \Sigma \nabla_\theta f_j */
+void MeasureEvaluationImplementation::computeTaylorExpansion(const Point & inP,
+    Sample & expansion,
+    Point & expansionMean,
+    Point & expansionVariance) const
+{
+  const Point mu(referenceDistribution_.getMean());
+  const CovarianceMatrix sigma(referenceDistribution_.getCovariance());
+  const UnsignedInteger parameterDimension = mu.getDimension();
+  Function function(function_);
+  function.setParameter(mu);
+  expansionMean = function(inP);
+  const Matrix parameterGradient(function.parameterGradient(inP));
+  const UnsignedInteger outputDimension = expansionMean.getDimension();
+  expansionVariance = Point(outputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    for (UnsignedInteger a = 0; a < parameterDimension; ++ a)
+      for (UnsignedInteger b = 0; b < parameterDimension; ++ b)
+        expansionVariance[j] += parameterGradient(a, j) * sigma(a, b) * parameterGradient(b, j);
+  const UnsignedInteger size = significantSupport_.getSize();
+  expansion = Sample(size, expansionMean);
+  for (UnsignedInteger k = 0; k < size; ++ k)
+    for (UnsignedInteger a = 0; a < parameterDimension; ++ a)
+    {
+      const Scalar delta = significantSupport_(k, a) - mu[a];
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        expansion(k, j) += parameterGradient(a, j) * delta;
+    }
+}
+
+/* Store the variance reduction of the current evaluation */
+void MeasureEvaluationImplementation::setLastVarianceReduction(const Point & reduction) const
+{
+  lastVarianceReduction_.set(reduction);
+}
+
+/* Evaluate the function at x on the significant support, through the shared cache if any */
+Sample MeasureEvaluationImplementation::evaluateSignificantSupport(const Point & inP) const
+{
+  if (!evaluationCache_.isEnabled()) return evaluateParametric(inP, significantSupport_);
+  Sample values(significantIndices_.getSize(), function_.getOutputDimension());
+  const Indices missing(evaluationCache_.find(inP, significantIndices_, values));
+  if (missing.getSize() == 0) return values;
+  // Only the nodes not yet evaluated by one of the measures sharing the cache
+  const Sample missingValues(evaluateParametric(inP, significantSupport_.select(missing)));
+  Indices missingNodes(missing.getSize());
+  for (UnsignedInteger k = 0; k < missing.getSize(); ++ k)
+  {
+    values[missing[k]] = missingValues[k];
+    missingNodes[k] = significantIndices_[missing[k]];
+  }
+  evaluationCache_.add(inP, missingNodes, missingValues);
+  return values;
+}
+
+/* Evaluate the function on the grid of design points times significant support */
+Sample MeasureEvaluationImplementation::evaluateSignificantSupport(const Sample & inS) const
+{
+  const UnsignedInteger size = inS.getSize();
+  const UnsignedInteger supportSize = significantSupport_.getSize();
+  const UnsignedInteger dimension = function_.getOutputDimension();
+  if (!evaluationCache_.isEnabled()) return evaluateParametric(inS, significantSupport_);
+  Sample outS(size * supportSize, dimension);
+  Sample valuesI(supportSize, dimension);
+  // The design points fully known by the shared cache are copied,
+  // the others are evaluated as one batch
+  Indices uncached(0);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    if (evaluationCache_.find(inS[i], significantIndices_, valuesI).getSize() == 0)
+    {
+      for (UnsignedInteger k = 0; k < supportSize; ++ k)
+        outS[i * supportSize + k] = valuesI[k];
+    }
+    else
+      uncached.add(i);
+  }
+  if (uncached.getSize() == 0) return outS;
+  const Sample values(evaluateParametric(inS.select(uncached), significantSupport_));
+  for (UnsignedInteger i = 0; i < uncached.getSize(); ++ i)
+  {
+    for (UnsignedInteger k = 0; k < supportSize; ++ k)
+    {
+      valuesI[k] = values[i * supportSize + k];
+      outS[uncached[i] * supportSize + k] = valuesI[k];
+    }
+    evaluationCache_.add(inS[uncached[i]], significantIndices_, valuesI);
+  }
+  return outS;
+}
+
+/* Same evaluations and reduction by another measure */
+Sample MeasureEvaluationImplementation::EvaluateSignificantSupport(const MeasureEvaluationImplementation & measure,
+    const Point & inP)
+{
+  return measure.evaluateSignificantSupport(inP);
+}
+
+Sample MeasureEvaluationImplementation::EvaluateSignificantSupport(const MeasureEvaluationImplementation & measure,
+    const Sample & inS)
+{
+  return measure.evaluateSignificantSupport(inS);
+}
+
+Point MeasureEvaluationImplementation::Reduce(const MeasureEvaluationImplementation & measure,
+    const Point & inP,
+    const Sample & values)
+{
+  return measure.reduce(inP, values);
+}
+
+UnsignedInteger MeasureEvaluationImplementation::GetSignificantSupportSize(const MeasureEvaluationImplementation & measure)
+{
+  return measure.significantSupport_.getSize();
+}
+
+/* Gradient of the function at x on the k-th node of the significant support */
+Matrix MeasureEvaluationImplementation::computeSignificantGradient(Function & function,
+    const Point & inP,
+    const UnsignedInteger k) const
+{
+  Matrix gradient;
+  if (evaluationCache_.findGradient(inP, significantIndices_[k], gradient)) return gradient;
+  function.setParameter(significantSupport_[k]);
+  gradient = function.gradient(inP);
+  evaluationCache_.addGradient(inP, significantIndices_[k], gradient);
+  return gradient;
+}
+
+/* Evaluate the function on the grid of design points times parameter values */
+Sample MeasureEvaluationImplementation::evaluateParametric(const Sample & inS,
+    const Sample & parameters) const
+{
+  const UnsignedInteger size = parameters.getSize();
+  const UnsignedInteger outputDimension = function_.getOutputDimension();
+  Sample outS(inS.getSize() * size, outputDimension);
+  if (outS.getSize() == 0) return outS;
+  // If the function is a ParametricFunction we build the (x, theta) sample of
+  // the underlying function in order to evaluate all the nodes in one call,
+  // which allows vectorized or batched functions to be exploited
+  const ParametricEvaluation * p_parametric = dynamic_cast<const ParametricEvaluation *>(function_.getEvaluation().getImplementation().get());
+  const Bool isParametric = (p_parametric != 0);
+  const Function function(isParametric ? p_parametric->getFunction() : function_);
+  const Indices inputPositions(isParametric ? p_parametric->getInputPositions() : Indices(0));
+  const Indices parametersPositions(isParametric ? p_parametric->getParametersPositions() : Indices(0));
+  // Partition the support into blocks evaluated concurrently if the function allows it
+  const UnsignedInteger blockSize = std::max<UnsignedInteger>(1, ResourceMap::GetAsUnsignedInteger("MeasureEvaluation-BlockSize"));
+  const UnsignedInteger blockNumber = (size + blockSize - 1) / blockSize;
+  const MeasureEvaluationParametricPolicy policy(inS, parameters, function, inputPositions, parametersPositions, isParametric, blockSize, outS);
+  if ((blockNumber > 1) && function.getEvaluation().getImplementation()->isParallel())
+    TBBImplementation::ParallelFor(0, blockNumber, policy);
+  else
+    policy(TBBImplementation::BlockedRange<UnsignedInteger>(0, blockNumber));
+  return outS;
+}
+
+
+/* This function is the kernel of the derivative moments computation:
+   for a given value of x \in R^d and of \Theta \in R^p, it returns
+   p(\Theta) * (f, f^2, \nabla_x f, f \nabla_x f) flattened marginal by marginal,
+   followed at order 2 by p(\Theta) * (\nabla^2_x f, \nabla_x f \nabla_x f^T, f \nabla^2_x f)
+   restricted to the lower triangle */
+class MeasureEvaluationDerivativeMomentsWrapper : public FunctionImplementation
+{
+public:
+  MeasureEvaluationDerivativeMomentsWrapper(const Point & x,
+      const Function & function,
+      const Distribution & distribution,
+      const UnsignedInteger order,
+      const Scalar pdfThreshold)
+    : FunctionImplementation()
+    , x_(x)
+    , function_(function)
+    , distribution_(distribution)
+    , order_(order)
+    , pdfThreshold_(pdfThreshold)
+  {}
+
+  MeasureEvaluationDerivativeMomentsWrapper * clone() const override
+  {
+    return new MeasureEvaluationDerivativeMomentsWrapper(*this);
+  }
+
+  Point operator()(const Point & theta) const override
+  {
+    const UnsignedInteger inputDimension = function_.getInputDimension();
+    const UnsignedInteger outputDimension = function_.getOutputDimension();
+    Point outP(getOutputDimension());
+    const Scalar pdf = distribution_.computePDF(theta);
+    if (pdf <= pdfThreshold_) return outP;
+    Function function(function_);
+    function.setParameter(theta);
+    const Point value(function(x_));
+    const Matrix gradient(function.gradient(x_));
+    UnsignedInteger index = 0;
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      outP[index++] = pdf * value[j];
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      outP[index++] = pdf * value[j] * value[j];
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        outP[index++] = pdf * gradient(i, j);
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        outP[index++] = pdf * value[j] * gradient(i, j);
+    if (order_ < 2) return outP;
+    const SymmetricTensor hessian(function.hessian(x_));
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          outP[index++] = pdf * hessian(a, b, j);
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          outP[index++] = pdf * gradient(a, j) * gradient(b, j);
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          outP[index++] = pdf * value[j] * hessian(a, b, j);
+    return outP;
+  }
+
+  Sample operator()(const Sample & theta) const override
+  {
+    const UnsignedInteger size = theta.getSize();
+    Sample outS(size, getOutputDimension());
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      outS[i] = operator()(theta[i]);
+    return outS;
+  }
+
+  UnsignedInteger getInputDimension() const override
+  {
+    return function_.getParameterDimension();
+  }
+
+  UnsignedInteger getOutputDimension() const override
+  {
+    const UnsignedInteger inputDimension = function_.getInputDimension();
+    const UnsignedInteger outputDimension = function_.getOutputDimension();
+    const UnsignedInteger gradientSize = 2 * outputDimension * (1 + inputDimension);
+    if (order_ < 2) return gradientSize;
+    return gradientSize + 3 * outputDimension * (inputDimension * (inputDimension + 1)) / 2;
+  }
+
+protected:
+  Point x_;
+  Function function_;
+  Distribution distribution_;
+  UnsignedInteger order_ = 1;
+  Scalar pdfThreshold_ = 0.0;
+};
+
+
+/* Mean and variance of f(x, Theta) and their derivatives with respect to x */
+void MeasureEvaluationImplementation::computeDerivativeMoments(const Point & inP,
+    const UnsignedInteger order,
+    Point & mean,
+    Point & variance,
+    Matrix & meanGradient,
+    Matrix & varianceGradient,
+    SymmetricTensor & meanHessian,
+    SymmetricTensor & varianceHessian) const
+{
+  const UnsignedInteger inputDimension = function_.getInputDimension();
+  const UnsignedInteger outputDimension = function_.getOutputDimension();
+  meanGradient = Matrix(inputDimension, outputDimension);
+  varianceGradient = Matrix(inputDimension, outputDimension);
+  meanHessian = SymmetricTensor(inputDimension, outputDimension);
+  varianceHessian = SymmetricTensor(inputDimension, outputDimension);
+  if (!hasSignificantSupport())
+  {
+    // All the moments are integrated at once, on the same nodes
+    Pointer<FunctionImplementation> p_wrapper(new MeasureEvaluationDerivativeMomentsWrapper(inP, function_, getDistribution(), order, pdfThreshold_));
+    const Function G(p_wrapper);
+    const Point integral(integrationAlgorithm_.integrate(G, getDistribution().getRange()));
+    mean = Point(outputDimension);
+    variance = Point(outputDimension);
+    UnsignedInteger index = 0;
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      mean[j] = integral[index++];
+    // Var(f(x))=\mathbb{E}(f^2(x))-\mathbb{E}(f(x))^2
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      variance[j] = integral[index++] - mean[j] * mean[j];
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        meanGradient(i, j) = integral[index++];
+    // \nabla Var(f(x))=2(\mathbb{E}(f\nabla f(x))-\mathbb{E}(f(x))\mathbb{E}(\nabla f(x)))
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        varianceGradient(i, j) = 2.0 * (integral[index++] - mean[j] * meanGradient(i, j));
+    if (order < 2) return;
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          meanHessian(a, b, j) = integral[index++];
+    // \nabla^2 Var(f(x))=2(\mathbb{E}(\nabla f\nabla f^T)+\mathbb{E}(f\nabla^2 f)-\nabla\mathbb{E}(f)\nabla\mathbb{E}(f)^T-\mathbb{E}(f)\mathbb{E}(\nabla^2 f))
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          varianceHessian(a, b, j) = integral[index++] - meanGradient(a, j) * meanGradient(b, j) - mean[j] * meanHessian(a, b, j);
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+          varianceHessian(a, b, j) = 2.0 * (varianceHessian(a, b, j) + integral[index++]);
+    return;
+  }
+  const Point & weights(significantWeights_);
+  const Sample values(evaluateSignificantSupport(inP));
+  ComputeWeightedMoments(values, weights, mean, variance);
+  // The derivatives of the variance use the centered values for stability
+  Function function(function_);
+  Scalar weightSum = 0.0;
+  for (UnsignedInteger k = 0; k < weights.getSize(); ++ k)
+  {
+    const Scalar weight = weights[k];
+    if (!(weight > 0.0)) continue;
+    weightSum += weight;
+    const Matrix gradient(computeSignificantGradient(function, inP, k));
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    {
+      const Scalar delta = values(k, j) - mean[j];
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+      {
+        meanGradient(i, j) += weight * gradient(i, j);
+        varianceGradient(i, j) += weight * delta * gradient(i, j);
+      }
+    }
+    if (order < 2) continue;
+    function.setParameter(significantSupport_[k]);
+    const SymmetricTensor hessian(function.hessian(inP));
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    {
+      const Scalar delta = values(k, j) - mean[j];
+      for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+        for (UnsignedInteger b = 0; b <= a; ++ b)
+        {
+          meanHessian(a, b, j) += weight * hessian(a, b, j);
+          varianceHessian(a, b, j) += weight * (gradient(a, j) * gradient(b, j) + delta * hessian(a, b, j));
+        }
+    }
+  }
+  if (!(weightSum > 0.0)) return;
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+    {
+      meanGradient(i, j) /= weightSum;
+      varianceGradient(i, j) *= 2.0 / weightSum;
+    }
+  if (order < 2) return;
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+    for (UnsignedInteger a = 0; a < inputDimension; ++ a)
+      for (UnsignedInteger b = 0; b <= a; ++ b)
+      {
+        meanHessian(a, b, j) /= weightSum;
+        varianceHessian(a, b, j) = 2.0 * (varianceHessian(a, b, j) / weightSum - meanGradient(a, j) * meanGradient(b, j));
+      }
+}
+
+
+/* Weighted mean and variance of each marginal of a sample in a single pass.
+   We use the weighted incremental update of West (1979), which is as stable
+   as the two-pass algorithm and does not need to normalize the weights */
+void MeasureEvaluationImplementation::ComputeWeightedMoments(const Sample & values,
+    const Point & weights,
+    Point & mean,
+    Point & variance)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  mean = Point(dimension);
+  variance = Point(dimension);
+  Scalar weightSum = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Scalar weight = weights[i];
+    if (!(weight > 0.0)) continue;
+    weightSum += weight;
+    const Scalar ratio = weight / weightSum;
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+    {
+      const Scalar delta = values(i, j) - mean[j];
+      mean[j] += ratio * delta;
+      // variance holds the weighted sum of squared deviations until the end
+      variance[j] += weight * delta * (values(i, j) - mean[j]);
+    }
+  }
+  if (weightSum > 0.0) variance /= weightSum;
+}
+
+/* Weighted regression of the values on a control variate. The coefficient c_j = Cov(f_j, g_j) / Var(g_j)
+   minimizes the variance of f_j - c_j g_j, whose ratio to the variance of f_j is 1 - \rho_j^2 */
+void MeasureEvaluationImplementation::ComputeControlVariate(const Sample & values,
+    const Sample & control,
+    const Point & weights,
+    Point & coefficient,
+    Point & controlVariance,
+    Point & reduction)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if ((control.getSize() != size) || (control.getDimension() != dimension))
+    throw InvalidArgumentException(HERE) << "Error: expected a control variate of size " << size << " and dimension " << dimension << ", got " << control.getSize() << " and " << control.getDimension();
+  Point valuesMean;
+  Point valuesVariance;
+  Point controlMean;
+  ComputeWeightedMoments(values, weights, valuesMean, valuesVariance);
+  ComputeWeightedMoments(control, weights, controlMean, controlVariance);
+  Point covariance(dimension);
+  Scalar weightSum = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Scalar weight = weights[i];
+    if (!(weight > 0.0)) continue;
+    weightSum += weight;
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      covariance[j] += weight * (values(i, j) - valuesMean[j]) * (control(i, j) - controlMean[j]);
+  }
+  if (weightSum > 0.0) covariance /= weightSum;
+  coefficient = Point(dimension);
+  reduction = Point(dimension, 1.0);
+  for (UnsignedInteger j = 0; j < dimension; ++ j)
+  {
+    // A constant control variate brings no information
+    if (!(controlVariance[j] > 0.0)) continue;
+    coefficient[j] = covariance[j] / controlVariance[j];
+    if (valuesVariance[j] > 0.0)
+      reduction[j] = std::max(0.0, 1.0 - coefficient[j] * covariance[j] / valuesVariance[j]);
+  }
+}
+
+/* Weighted quantile of the first marginal of a sample by partial selection */
+Scalar MeasureEvaluationImplementation::ComputeWeightedQuantile(const Sample & values,
+    const Point & weights,
+    const Scalar alpha)
+{
+  const UnsignedInteger size = values.getSize();
+  if (size == 0)
+    throw InvalidArgumentException(HERE) << "Error: cannot compute the quantile of an empty sample";
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  // (value, weight) pairs, kept between calls to avoid reallocations
+  typedef std::vector<std::pair<Scalar, Scalar> > ScratchType;
+  static thread_local ScratchType scratch;
+  scratch.resize(size);
+  Scalar weightSum = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    scratch[i] = std::make_pair(values(i, 0), weights[i]);
+    weightSum += weights[i];
+  }
+  // Smallest value v such that P(X <= v) >= alpha. The partial sums are not
+  // accumulated in sorted order, so the comparison tolerates rounding errors
+  // in order to resolve exact ties toward the lower value
+  const Scalar target = alpha * weightSum * (1.0 - size * SpecFunc::ScalarEpsilon);
+  ScratchType::iterator first = scratch.begin();
+  ScratchType::iterator last = scratch.end();
+  Scalar cumulated = 0.0;
+  while (last - first > 1)
+  {
+    const ScratchType::iterator middle = first + (last - first) / 2;
+    std::nth_element(first, middle, last, [](const std::pair<Scalar, Scalar> & a, const std::pair<Scalar, Scalar> & b)
+    {
+      return a.first < b.first;
+    });
+    Scalar leftWeight = 0.0;
+    for (ScratchType::iterator it = first; it != middle; ++ it)
+      leftWeight += it->second;
+    if (cumulated + leftWeight >= target)
+      last = middle;
+    else
+    {
+      cumulated += leftWeight;
+      first = middle;
+    }
+  }
+  return first->first;
+}
+
+/* Weighted probability that each marginal of a sample is nonnegative */
+Point MeasureEvaluationImplementation::ComputeWeightedExceedance(const Sample & values,
+    const Point & weights)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  Point probabilities(dimension);
+  if (size == 0) return probabilities;
+  // The sample is stored row by row: the inner loop runs over contiguous
+  // marginals without branching so that it can be vectorized
+  const Scalar * data = values.getImplementation()->data_begin();
+  Scalar * accumulator = &probabilities[0];
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Scalar weight = weights[i];
+    const Scalar * row = data + i * dimension;
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      accumulator[j] += (row[j] >= 0.0) ? weight : 0.0;
+  }
+  return probabilities;
+}
+
+/* Weighted probability that all the marginals of a sample are nonnegative */
+Scalar MeasureEvaluationImplementation::ComputeWeightedJointExceedance(const Sample & values,
+    const Point & weights)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  if (size == 0) return 0.0;
+  const Scalar * data = values.getImplementation()->data_begin();
+  Scalar probability = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Scalar * row = data + i * dimension;
+    // Count the violated marginals instead of breaking on the first one
+    UnsignedInteger violations = 0;
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      violations += (row[j] < 0.0);
+    probability += (violations == 0) ? weights[i] : 0.0;
+  }
+  return probability;
+}
+
+/* Weighted smoothed probability that each marginal of a sample is nonnegative */
+Point MeasureEvaluationImplementation::ComputeWeightedSmoothedExceedance(const Sample & values,
+    const Point & weights,
+    const Scalar bandwidth)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  Point probabilities(dimension);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      probabilities[j] += weights[i] * DistFunc::pNormal(values(i, j) / bandwidth);
+  return probabilities;
+}
+
+/* Weighted smoothed probability that all the marginals of a sample are nonnegative */
+Scalar MeasureEvaluationImplementation::ComputeWeightedSmoothedJointExceedance(const Sample & values,
+    const Point & weights,
+    const Scalar bandwidth)
+{
+  const UnsignedInteger size = values.getSize();
+  const UnsignedInteger dimension = values.getDimension();
+  if (weights.getSize() != size)
+    throw InvalidArgumentException(HERE) << "Error: expected weights of size " << size << ", got " << weights.getSize();
+  Scalar probability = 0.0;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    Scalar product = weights[i];
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      product *= DistFunc::pNormal(values(i, j) / bandwidth);
+    probability += product;
+  }
+  return probability;
+}
+
 
 /* String converter */
 String MeasureEvaluationImplementation::__repr__() const
@@ -91,7 +1172,17 @@ String MeasureEvaluationImplementation::__str__(const String & offset) const
 /* Distribution accessor */
 void MeasureEvaluationImplementation::setDistribution(const Distribution & distribution)
 {
+  // A discretization keeps the moments of the continuous distribution it replaces
+  if (distribution.isContinuous()) referenceDistribution_ = distribution;
+  else if (distribution_.isContinuous()) referenceDistribution_ = distribution_;
   distribution_ = distribution;
+  updateIntegrationAlgorithm();
+  updateSignificantSupport();
+  lastError_.set(Point());
+  lastVarianceReduction_.set(Point());
+  proposals_.clear();
+  // The cached values are tied to the nodes of the previous distribution
+  evaluationCache_ = MeasureEvaluationCache();
 }
 
 
@@ -105,6 +1196,186 @@ Distribution MeasureEvaluationImplementation::getDistribution() const
 void MeasureEvaluationImplementation::setFunction(const Function & function)
 {
   function_ = function;
+  evaluationCache_ = MeasureEvaluationCache();
+  proposals_.clear();
+}
+
+/* Requested accuracy of the integration over a continuous distribution */
+void MeasureEvaluationImplementation::setMaximumError(const Scalar maximumError)
+{
+  if (!(maximumError > 0.0)) throw InvalidArgumentException(HERE) << "The maximum error must be positive";
+  maximumError_ = maximumError;
+  // The values over a discrete distribution do not depend on the accuracy, nor their shared cache
+  if (!distribution_.isContinuous()) return;
+  const IntegrationAlgorithmImplementation * p_algorithm = integrationAlgorithm_.getImplementation().get();
+  if (const GaussKronrod * p_gaussKronrod = dynamic_cast<const GaussKronrod *>(p_algorithm))
+  {
+    GaussKronrod algorithm(*p_gaussKronrod);
+    algorithm.setMaximumError(maximumError_);
+    setIntegrationAlgorithm(algorithm);
+  }
+  else if (const SparseGridIntegration * p_sparseGrid = dynamic_cast<const SparseGridIntegration *>(p_algorithm))
+  {
+    SparseGridIntegration algorithm(*p_sparseGrid);
+    algorithm.setMaximumError(maximumError_);
+    setIntegrationAlgorithm(algorithm);
+  }
+  else if (hasIteratedRule_)
+  {
+    GaussKronrod rule(iteratedRule_);
+    rule.setMaximumError(maximumError_);
+    setIntegrationAlgorithm(IteratedQuadrature(rule));
+    iteratedRule_ = rule;
+    hasIteratedRule_ = true;
+  }
+  // The accuracy of the other algorithms cannot be tuned, they are left unchanged
+}
+
+Scalar MeasureEvaluationImplementation::getMaximumError() const
+{
+  return maximumError_;
+}
+
+/* Error estimate of the last evaluation over a continuous distribution */
+Point MeasureEvaluationImplementation::getLastError() const
+{
+  return lastError_.get();
+}
+
+/* Next step of the smoothing bandwidth schedule, the measures are not smoothed unless overloaded */
+Bool MeasureEvaluationImplementation::reduceSmoothingBandwidth()
+{
+  return false;
+}
+
+/* Variance reduction of the control variate at the last evaluation */
+Point MeasureEvaluationImplementation::getLastVarianceReduction() const
+{
+  return lastVarianceReduction_.get();
+}
+
+
+MeasureEvaluationImplementation::PointRecord::PointRecord()
+{
+  // Nothing to do
+}
+
+MeasureEvaluationImplementation::PointRecord::PointRecord(const PointRecord & other)
+{
+  value_ = other.get();
+}
+
+MeasureEvaluationImplementation::PointRecord & MeasureEvaluationImplementation::PointRecord::operator =(const PointRecord & other)
+{
+  if (this != &other) set(other.get());
+  return *this;
+}
+
+void MeasureEvaluationImplementation::PointRecord::set(const Point & value)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  value_ = value;
+}
+
+Point MeasureEvaluationImplementation::PointRecord::get() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return value_;
+}
+
+MeasureEvaluationImplementation::ProposalCache::ProposalCache()
+{
+  // Nothing to do
+}
+
+MeasureEvaluationImplementation::ProposalCache::ProposalCache(const ProposalCache & other)
+{
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  standardSample_ = other.standardSample_;
+  means_ = other.means_;
+  sigmas_ = other.sigmas_;
+}
+
+MeasureEvaluationImplementation::ProposalCache & MeasureEvaluationImplementation::ProposalCache::operator =(const ProposalCache & other)
+{
+  if (this != &other)
+  {
+    std::lock(mutex_, other.mutex_);
+    std::lock_guard<std::mutex> lock(mutex_, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other.mutex_, std::adopt_lock);
+    standardSample_ = other.standardSample_;
+    means_ = other.means_;
+    sigmas_ = other.sigmas_;
+  }
+  return *this;
+}
+
+Sample MeasureEvaluationImplementation::ProposalCache::getStandardSample(const UnsignedInteger size,
+    const UnsignedInteger dimension)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((standardSample_.getSize() != size) || (standardSample_.getDimension() != dimension))
+    standardSample_ = Normal(dimension).getSample(size);
+  return standardSample_;
+}
+
+Bool MeasureEvaluationImplementation::ProposalCache::find(const UnsignedInteger slot,
+    Point & mean,
+    Point & sigma) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((slot >= means_.getSize()) || (means_[slot].getDimension() == 0)) return false;
+  mean = means_[slot];
+  sigma = sigmas_[slot];
+  return true;
+}
+
+void MeasureEvaluationImplementation::ProposalCache::set(const UnsignedInteger slot,
+    const Point & mean,
+    const Point & sigma)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (slot >= means_.getSize())
+  {
+    means_.resize(slot + 1);
+    sigmas_.resize(slot + 1);
+  }
+  means_[slot] = mean;
+  sigmas_[slot] = sigma;
+}
+
+void MeasureEvaluationImplementation::ProposalCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  means_.clear();
+  sigmas_.clear();
+}
+
+/* Cache of the function values shared with other measures */
+void MeasureEvaluationImplementation::setEvaluationCache(const MeasureEvaluationCache & cache)
+{
+  evaluationCache_ = cache;
+}
+
+MeasureEvaluationCache MeasureEvaluationImplementation::getEvaluationCache() const
+{
+  return evaluationCache_;
+}
+
+/* Number of nodes indexing the values shared with other measures */
+UnsignedInteger MeasureEvaluationImplementation::getNodesNumber() const
+{
+  return nodesNumber_;
+}
+
+/* Whether the values of the function are reduced over the same nodes as another measure */
+Bool MeasureEvaluationImplementation::hasSameNodes(const MeasureEvaluationImplementation & other) const
+{
+  if ((nodesNumber_ == 0) || (other.nodesNumber_ != nodesNumber_) || !(other.distribution_ == distribution_)) return false;
+  // The support of a discrete distribution is indexed the same way whatever the PDF threshold
+  if (!distribution_.isContinuous()) return true;
+  // The nodes of a fixed rule also depend on the algorithm, the retained ones are compared
+  return (other.significantIndices_ == significantIndices_) && (other.significantSupport_ == significantSupport_);
 }
 
 Function MeasureEvaluationImplementation::getFunction() const
@@ -123,10 +1394,25 @@ UnsignedInteger MeasureEvaluationImplementation::getOutputDimension() const
   return function_.getOutputDimension();
 }
 
+/* Default integration algorithm set by the constructors, whose inner rule follows the requested accuracy */
+void MeasureEvaluationImplementation::setIteratedQuadrature(const GaussKronrod & rule)
+{
+  integrationAlgorithm_ = IteratedQuadrature(rule);
+  iteratedRule_ = rule;
+  hasIteratedRule_ = true;
+}
+
 /* Integration algorithm$ accessor */
 void MeasureEvaluationImplementation::setIntegrationAlgorithm(const IntegrationAlgorithm & algorithm)
 {
   integrationAlgorithm_ = algorithm;
+  hasIteratedRule_ = false;
+  updateIntegrationAlgorithm();
+  // The nodes of a fixed rule are computed once for all the design points
+  updateSignificantSupport();
+  evaluationCache_ = MeasureEvaluationCache();
+  lastError_.set(Point());
+  lastVarianceReduction_.set(Point());
 }
 
 IntegrationAlgorithm MeasureEvaluationImplementation::getIntegrationAlgorithm() const
@@ -144,6 +1430,7 @@ Scalar MeasureEvaluationImplementation::getPDFThreshold() const
 void MeasureEvaluationImplementation::setPDFThreshold(const Scalar threshold)
 {
   pdfThreshold_ = threshold;
+  updateSignificantSupport();
 }
 
 
@@ -155,6 +1442,11 @@ void MeasureEvaluationImplementation::save(Advocate & adv) const
   adv.saveAttribute("function_", function_);
   adv.saveAttribute("integrationAlgorithm_", integrationAlgorithm_);
   adv.saveAttribute("pdfThreshold_", pdfThreshold_);
+  adv.saveAttribute("maximumError_", maximumError_);
+  adv.saveAttribute("referenceDistribution_", referenceDistribution_);
+  adv.saveAttribute("iteratedRule_", iteratedRule_);
+  adv.saveAttribute("hasIteratedRule_", hasIteratedRule_);
+  adv.saveAttribute("sweepNodesNumber_", sweepNodesNumber_);
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -165,6 +1457,21 @@ void MeasureEvaluationImplementation::load(Advocate & adv)
   adv.loadAttribute("function_", function_);
   adv.loadAttribute("integrationAlgorithm_", integrationAlgorithm_);
   adv.loadAttribute("pdfThreshold_", pdfThreshold_);
+  if (adv.hasAttribute("maximumError_"))
+    adv.loadAttribute("maximumError_", maximumError_);
+  if (adv.hasAttribute("referenceDistribution_"))
+    adv.loadAttribute("referenceDistribution_", referenceDistribution_);
+  else
+    referenceDistribution_ = distribution_;
+  if (adv.hasAttribute("hasIteratedRule_"))
+  {
+    adv.loadAttribute("iteratedRule_", iteratedRule_);
+    adv.loadAttribute("hasIteratedRule_", hasIteratedRule_);
+  }
+  if (adv.hasAttribute("sweepNodesNumber_"))
+    adv.loadAttribute("sweepNodesNumber_", sweepNodesNumber_);
+  updateSignificantSupport();
+  evaluationCache_ = MeasureEvaluationCache();
 }
 
 } /* namespace OTROBOPT */
@@ -99,6 +99,8 @@ MeasureFactory::MeasureEvaluationCollection MeasureFactory::buildCollection(cons
   {
     result[i].setDistribution(discretizedDistribution);
   }
+  // The measures of the same function evaluate it once per node
+  MeasureEvaluationCache::Share(result);
   return result;
 }
 
@@ -40,12 +40,14 @@ MeasureFunction::MeasureFunction()
   // Nothing to do
 }
 
-/* Default constructor */
+/* Parameter constructor */
 MeasureFunction::MeasureFunction(const MeasureEvaluation & evaluation)
   : FunctionImplementation(Evaluation(evaluation.getImplementation()))
   , evaluation_(evaluation)
 {
-  // Nothing to do
+  // The measures provide their own gradient and hessian, analytical when available
+  setGradient(new MeasureGradient(evaluation));
+  setHessian(new MeasureHessian(evaluation));
 }
 
 
@@ -63,13 +65,7 @@ Point MeasureFunction::operator()(const Point & inP) const
 
 Sample MeasureFunction::operator()(const Sample & inS) const
 {
-  const UnsignedInteger size = inS.getSize();
-  Sample outS(size, getOutputDimension());
-  for (UnsignedInteger i = 0; i < size; ++ i)
-  {
-    outS[i] = operator()(inS[i]);
-  }
-  return outS;
+  return evaluation_.operator()(inS);
 }
 
 
@@ -0,0 +1,97 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Measure function gradient
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/MeasureGradient.hxx"
+#include "otrobopt/MeasureEvaluationImplementation.hxx"
+#include <openturns/PersistentObjectFactory.hxx>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+
+CLASSNAMEINIT(MeasureGradient)
+
+static Factory<MeasureGradient> Factory_MeasureGradient;
+
+/* Default constructor */
+MeasureGradient::MeasureGradient()
+  : GradientImplementation()
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+MeasureGradient::MeasureGradient(const MeasureEvaluation & evaluation)
+  : GradientImplementation()
+  , evaluation_(evaluation)
+{
+  // Nothing to do
+}
+
+
+MeasureGradient * MeasureGradient::clone() const
+{
+  return new MeasureGradient(*this);
+}
+
+
+/* Gradient */
+Matrix MeasureGradient::gradient(const Point & inP) const
+{
+  return evaluation_.gradient(inP);
+}
+
+
+UnsignedInteger MeasureGradient::getInputDimension() const
+{
+  return evaluation_.getImplementation()->getInputDimension();
+}
+
+UnsignedInteger MeasureGradient::getOutputDimension() const
+{
+  return evaluation_.getImplementation()->getOutputDimension();
+}
+
+/* String converter */
+String MeasureGradient::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MeasureGradient::GetClassName()
+      << " evaluation=" << evaluation_;
+  return oss;
+}
+
+/* Method save() stores the object through the StorageManager */
+void MeasureGradient::save(Advocate & adv) const
+{
+  GradientImplementation::save(adv);
+  adv.saveAttribute("evaluation_", evaluation_);
+}
+
+/* Method load() reloads the object from the StorageManager */
+void MeasureGradient::load(Advocate & adv)
+{
+  GradientImplementation::load(adv);
+  adv.loadAttribute("evaluation_", evaluation_);
+}
+
+} /* namespace OTROBOPT */
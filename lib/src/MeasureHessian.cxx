@@ -0,0 +1,97 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Measure function hessian
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/MeasureHessian.hxx"
+#include "otrobopt/MeasureEvaluationImplementation.hxx"
+#include <openturns/PersistentObjectFactory.hxx>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+
+CLASSNAMEINIT(MeasureHessian)
+
+static Factory<MeasureHessian> Factory_MeasureHessian;
+
+/* Default constructor */
+MeasureHessian::MeasureHessian()
+  : HessianImplementation()
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+MeasureHessian::MeasureHessian(const MeasureEvaluation & evaluation)
+  : HessianImplementation()
+  , evaluation_(evaluation)
+{
+  // Nothing to do
+}
+
+
+MeasureHessian * MeasureHessian::clone() const
+{
+  return new MeasureHessian(*this);
+}
+
+
+/* Hessian */
+SymmetricTensor MeasureHessian::hessian(const Point & inP) const
+{
+  return evaluation_.hessian(inP);
+}
+
+
+UnsignedInteger MeasureHessian::getInputDimension() const
+{
+  return evaluation_.getImplementation()->getInputDimension();
+}
+
+UnsignedInteger MeasureHessian::getOutputDimension() const
+{
+  return evaluation_.getImplementation()->getOutputDimension();
+}
+
+/* String converter */
+String MeasureHessian::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MeasureHessian::GetClassName()
+      << " evaluation=" << evaluation_;
+  return oss;
+}
+
+/* Method save() stores the object through the StorageManager */
+void MeasureHessian::save(Advocate & adv) const
+{
+  HessianImplementation::save(adv);
+  adv.saveAttribute("evaluation_", evaluation_);
+}
+
+/* Method load() reloads the object from the StorageManager */
+void MeasureHessian::load(Advocate & adv)
+{
+  HessianImplementation::load(adv);
+  adv.loadAttribute("evaluation_", evaluation_);
+}
+
+} /* namespace OTROBOPT */
@@ -23,13 +23,8 @@
 #include <openturns/GaussKronrod.hxx>
 #include <openturns/IteratedQuadrature.hxx>
 #include <openturns/Brent.hxx>
-
-#if OPENTURNS_VERSION >= 102700
-#include <openturns/FiniteDiscreteDistribution.hxx>
-#else
-#include <openturns/UserDefined.hxx>
-#define FiniteDiscreteDistribution UserDefined
-#endif
+#include <openturns/ResourceMap.hxx>
+#include <openturns/SpecFunc.hxx>
 
 using namespace OT;
 
@@ -44,11 +39,13 @@ static Factory<QuantileMeasure> Factory_QuantileMeasure;
 /* Default constructor */
 QuantileMeasure::QuantileMeasure()
   : MeasureEvaluationImplementation()
+  , singleSweep_(ResourceMap::GetAsBool("QuantileMeasure-SingleSweep"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("QuantileMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
+  setSingleSweep(singleSweep_);
 }
 
 /* Parameter constructor */
@@ -56,6 +53,7 @@ QuantileMeasure::QuantileMeasure (const Function & function,
                                   const Distribution & distribution,
                                   const Scalar alpha)
   : MeasureEvaluationImplementation(function, distribution)
+  , singleSweep_(ResourceMap::GetAsBool("QuantileMeasure-SingleSweep"))
 {
   setAlpha(alpha);
   if (function.getOutputDimension() > 1) throw InvalidArgumentException(HERE) << "Quantile are only computed for 1-d functions.";
@@ -63,7 +61,8 @@ QuantileMeasure::QuantileMeasure (const Function & function,
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("QuantileMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
+  setSingleSweep(singleSweep_);
 }
 
 /* Virtual constructor method */
@@ -72,6 +71,65 @@ QuantileMeasure * QuantileMeasure::clone() const
   return new QuantileMeasure(*this);
 }
 
+
+QuantileMeasure::BracketCache::BracketCache()
+{
+  // Nothing to do
+}
+
+QuantileMeasure::BracketCache::BracketCache(const BracketCache & other)
+{
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  x_ = other.x_;
+  quantile_ = other.quantile_;
+  step_ = other.step_;
+  hasValue_ = other.hasValue_;
+}
+
+QuantileMeasure::BracketCache & QuantileMeasure::BracketCache::operator =(const BracketCache & other)
+{
+  if (this != &other)
+  {
+    std::lock(mutex_, other.mutex_);
+    std::lock_guard<std::mutex> lock(mutex_, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other.mutex_, std::adopt_lock);
+    x_ = other.x_;
+    quantile_ = other.quantile_;
+    step_ = other.step_;
+    hasValue_ = other.hasValue_;
+  }
+  return *this;
+}
+
+Bool QuantileMeasure::BracketCache::find(Point & x,
+    Scalar & quantile,
+    Scalar & step) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!hasValue_) return false;
+  x = x_;
+  quantile = quantile_;
+  step = step_;
+  return true;
+}
+
+void QuantileMeasure::BracketCache::set(const Point & x,
+                                        const Scalar quantile,
+                                        const Scalar step)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  x_ = x;
+  quantile_ = quantile;
+  step_ = step;
+  hasValue_ = true;
+}
+
+void QuantileMeasure::BracketCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  hasValue_ = false;
+}
+
 /* This function is the kernel of the CDF computation of f(x,\Theta):
    for a given value of x \in R^d, a given value of \Theta \in R^p,
    a given value of s \in R, it returns 1_{f(x,\Theta)<=s} */
@@ -123,7 +181,7 @@ public:
       const UnsignedInteger j = significant[i];
       function.setParameter(theta[j]);
       const Scalar y = function(x_)[0];
-      outS(i, 0) = (y <= s_ ? pdfs[j] : 0.0);
+      outS(j, 0) = (y <= s_ ? pdfs[j] : 0.0);
     }
     return outS;
   }
@@ -224,6 +282,122 @@ protected:
 };
 
 
+/* This function is the kernel of the bandwidth computation:
+   for a given value of x \in R^d and of \Theta \in R^p,
+   it returns p(\Theta) * (f(x,\Theta), f(x,\Theta)^2) */
+class QuantileMeasureMomentsWrapper : public FunctionImplementation
+{
+public:
+  QuantileMeasureMomentsWrapper(const Point & x,
+                                const Function & function,
+                                const Distribution & distribution,
+                                const Scalar pdfThreshold)
+    : FunctionImplementation()
+    , x_(x)
+    , function_(function)
+    , distribution_(distribution)
+    , pdfThreshold_(pdfThreshold)
+  {}
+
+  QuantileMeasureMomentsWrapper * clone() const override
+  {
+    return new QuantileMeasureMomentsWrapper(*this);
+  }
+
+  Point operator()(const Point & theta) const override
+  {
+    Point outP(2);
+    const Scalar pdf = distribution_.computePDF(theta);
+    if (pdf <= pdfThreshold_) return outP;
+    Function function(function_);
+    function.setParameter(theta);
+    const Scalar y = function(x_)[0];
+    outP[0] = pdf * y;
+    outP[1] = pdf * y * y;
+    return outP;
+  }
+
+  UnsignedInteger getInputDimension() const override
+  {
+    return function_.getParameterDimension();
+  }
+
+  UnsignedInteger getOutputDimension() const override
+  {
+    return 2;
+  }
+
+protected:
+  Point x_;
+  Function function_;
+  Distribution distribution_;
+  Scalar pdfThreshold_ = 0.0;
+};
+
+/* This function is the kernel of the gradient computation:
+   for a given value of x \in R^d and of \Theta \in R^p, it returns
+   p(\Theta) * K((q - f(x,\Theta)) / h) * (1, \nabla_x f(x,\Theta))
+   where K is the (unnormalized) gaussian kernel */
+class QuantileMeasureGradientWrapper : public FunctionImplementation
+{
+public:
+  QuantileMeasureGradientWrapper(const Point & x,
+                                 const Function & function,
+                                 const Distribution & distribution,
+                                 const Scalar quantile,
+                                 const Scalar bandwidth,
+                                 const Scalar pdfThreshold)
+    : FunctionImplementation()
+    , x_(x)
+    , function_(function)
+    , distribution_(distribution)
+    , quantile_(quantile)
+    , bandwidth_(bandwidth)
+    , pdfThreshold_(pdfThreshold)
+  {}
+
+  QuantileMeasureGradientWrapper * clone() const override
+  {
+    return new QuantileMeasureGradientWrapper(*this);
+  }
+
+  Point operator()(const Point & theta) const override
+  {
+    Point outP(getOutputDimension());
+    const Scalar pdf = distribution_.computePDF(theta);
+    if (pdf <= pdfThreshold_) return outP;
+    Function function(function_);
+    function.setParameter(theta);
+    const Scalar u = (quantile_ - function(x_)[0]) / bandwidth_;
+    // The gradient of f is only needed where the kernel is not negligible
+    if (std::abs(u) > MeasureEvaluationImplementation::KernelSupport) return outP;
+    const Scalar kernel = pdf * std::exp(-0.5 * u * u);
+    const Matrix gradient(function.gradient(x_));
+    outP[0] = kernel;
+    for (UnsignedInteger i = 0; i < gradient.getNbRows(); ++ i)
+      outP[i + 1] = kernel * gradient(i, 0);
+    return outP;
+  }
+
+  UnsignedInteger getInputDimension() const override
+  {
+    return function_.getParameterDimension();
+  }
+
+  UnsignedInteger getOutputDimension() const override
+  {
+    return 1 + function_.getInputDimension();
+  }
+
+protected:
+  Point x_;
+  Function function_;
+  Distribution distribution_;
+  Scalar quantile_ = 0.0;
+  Scalar bandwidth_ = 1.0;
+  Scalar pdfThreshold_ = 0.0;
+};
+
 
 /* Evaluation */
 Point QuantileMeasure::operator()(const Point & inP) const
@@ -231,14 +405,21 @@ Point QuantileMeasure::operator()(const Point & inP) const
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
-  if (getDistribution().isContinuous())
+  if (!hasSignificantSupport())
   {
+    // Start from the last quantile, which is exact at the same point
+    Point lastX;
+    Scalar lower = 0.0;
+    Scalar step = 1.0;
+    if (lastBracket_.find(lastX, lower, step) && (lastX == inP))
+    {
+      outP[0] = lower;
+      return outP;
+    }
     Pointer<FunctionImplementation> p_wrapper(new QuantileMeasureParametricFunctionWrapper2(inP, function, getDistribution(), integrationAlgorithm_, pdfThreshold_));
     Function G(p_wrapper);
 
-    Scalar lower = 0.0;
-    Scalar upper = 0.0;
-    Scalar step = 1.0;
+    Scalar upper = lower;
     Scalar cdfMin = G(Point(1, lower))[0];
     Scalar cdfMax = cdfMin;
     // Go backward until we find a point below the threshold
@@ -250,56 +431,146 @@ Point QuantileMeasure::operator()(const Point & inP) const
       cdfMin = G(Point(1, lower))[0];
       step *= 2.0;
     }
-    // If the initial lower bound was an actual lower bound
-    // Try to narrow the lower bound
-    if (step == 1.0)
+    // Else go forward until we find a point above the threshold
+    while (cdfMax <= alpha_)
     {
+      lower = upper;
+      cdfMin = cdfMax;
       upper += step;
       cdfMax = G(Point(1, upper))[0];
       step *= 2.0;
-      while (cdfMax <= alpha_)
-      {
-        lower = upper;
-        cdfMin = cdfMax;
-        upper += step;
-        cdfMax = G(Point(1, upper))[0];
-        step *= 2.0;
-      }
-    } // step == 1
+    }
     const Brent solver;
     outP[0] = solver.solve(G, alpha_, lower, upper, cdfMin, cdfMax);
+    // The next step moves the CDF by a fixed probability according to its mean slope over the bracket
+    const Scalar slope = (cdfMax - cdfMin) / (upper - lower);
+    const Scalar nextStep = ResourceMap::GetAsScalar("QuantileMeasure-BracketProbabilityStep") / slope;
+    lastBracket_.set(inP, outP[0], ((nextStep > 0.0) && SpecFunc::IsNormal(nextStep) ? nextStep : 1.0));
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    Sample values(0, outputDimension);
-    Point weights(0);
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-          weights.add(pdfs[i]);
-        }
-    } // for
-
-    // Here we use a FiniteDiscreteDistribution distribution because the algorithm
-    // to compute a central moment is quite involved in the case of
-    // nonuniform weights
-    outP = FiniteDiscreteDistribution(values, weights).computeQuantile(alpha_);
+    outP = reduce(inP, evaluateSignificantSupport(inP));
   }
   return outP;
 }
 
+/* Gradient.
+   The quantile q(x) solves F(x, q(x)) = alpha where F(x, s) = P(f(x,\Theta) <= s), so by the
+   implicit function theorem \nabla q = -\partial_x F / \partial_s F = \mathbb{E}(\nabla_x f | f = q).
+   The conditional expectation is estimated by smoothing the indicator with a gaussian kernel
+   of bandwidth h, which gives the ratio \mathbb{E}(K_h(q - f) \nabla_x f) / \mathbb{E}(K_h(q - f)) */
+Matrix QuantileMeasure::gradient(const Point & inP) const
+{
+  const Function function(getFunction());
+  const UnsignedInteger inputDimension = function.getInputDimension();
+  Matrix result(inputDimension, 1);
+  Scalar kernelSum = 0.0;
+  if (!hasSignificantSupport())
+  {
+    const Scalar quantile = operator()(inP)[0];
+    // The bandwidth is a fraction of the standard deviation of f(x,\Theta)
+    Pointer<FunctionImplementation> p_momentsWrapper(new QuantileMeasureMomentsWrapper(inP, function, getDistribution(), pdfThreshold_));
+    const Point moments(integrationAlgorithm_.integrate(Function(p_momentsWrapper), getDistribution().getRange()));
+    const Scalar sigma = std::sqrt(std::max(0.0, moments[1] - moments[0] * moments[0]));
+    const Scalar bandwidth = ComputeBandwidth(sigma, SpecFunc::MaxScalar);
+    Pointer<FunctionImplementation> p_gradientWrapper(new QuantileMeasureGradientWrapper(inP, function, getDistribution(), quantile, bandwidth, pdfThreshold_));
+    const Point integral(integrationAlgorithm_.integrate(Function(p_gradientWrapper), getDistribution().getRange()));
+    kernelSum = integral[0];
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+      result(i, 0) = integral[i + 1];
+  }
+  else
+  {
+    // The quantile and the bandwidth are computed from the same values
+    const Point & weights(getSignificantWeights());
+    const Sample values(evaluateSignificantSupport(inP));
+    const Scalar quantile = ComputeWeightedQuantile(values, weights, alpha_);
+    Point mean;
+    Point variance;
+    ComputeWeightedMoments(values, weights, mean, variance);
+    // Effective size of the weighted support
+    Scalar weightSum = 0.0;
+    Scalar weightSquareSum = 0.0;
+    for (UnsignedInteger k = 0; k < weights.getSize(); ++ k)
+    {
+      weightSum += weights[k];
+      weightSquareSum += weights[k] * weights[k];
+    }
+    const Scalar effectiveSize = (weightSquareSum > 0.0 ? weightSum * weightSum / weightSquareSum : 1.0);
+    const Scalar bandwidth = ComputeBandwidth(std::sqrt(variance[0]), effectiveSize);
+    Function parametric(function);
+    for (UnsignedInteger k = 0; k < values.getSize(); ++ k)
+    {
+      const Scalar u = (quantile - values(k, 0)) / bandwidth;
+      if (!(weights[k] > 0.0) || (std::abs(u) > KernelSupport)) continue;
+      const Scalar kernel = weights[k] * std::exp(-0.5 * u * u);
+      const Matrix gradient(computeSignificantGradient(parametric, inP, k));
+      kernelSum += kernel;
+      for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+        result(i, 0) += kernel * gradient(i, 0);
+    }
+  }
+  // The kernel missed all the nodes, fall back to finite differences
+  if (!(kernelSum > 0.0)) return MeasureEvaluationImplementation::gradient(inP);
+  for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+    result(i, 0) /= kernelSum;
+  return result;
+}
+
+/* Bandwidth of the gradient kernel for f(x,\Theta) of standard deviation sigma over nodes of the given
+   effective size: Silverman's rule of thumb 1.06 sigma n^{-1/5}, bounded below by the relative bandwidth
+   of the ResourceMap, which is the only term left for an adaptive integration with n infinite */
+Scalar QuantileMeasure::ComputeBandwidth(const Scalar sigma,
+    const Scalar effectiveSize)
+{
+  if (!(sigma > 0.0)) return 1.0;
+  const Scalar relativeBandwidth = ResourceMap::GetAsScalar("QuantileMeasure-RelativeBandwidth");
+  return sigma * std::max(relativeBandwidth, 1.06 * std::pow(effectiveSize, -0.2));
+}
+
+/* Reduction of the function values over the retained discrete support */
+Point QuantileMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  // Weighted selection, no need to sort the whole support
+  return Point(1, ComputeWeightedQuantile(values, weights, alpha_));
+}
+
+/* Distribution accessor */
+void QuantileMeasure::setDistribution(const Distribution & distribution)
+{
+  MeasureEvaluationImplementation::setDistribution(distribution);
+  lastBracket_.clear();
+}
+
+/* Function accessor */
+void QuantileMeasure::setFunction(const Function & function)
+{
+  MeasureEvaluationImplementation::setFunction(function);
+  lastBracket_.clear();
+}
+
+/* Integration algorithm accessor */
+void QuantileMeasure::setIntegrationAlgorithm(const IntegrationAlgorithm & algorithm)
+{
+  MeasureEvaluationImplementation::setIntegrationAlgorithm(algorithm);
+  lastBracket_.clear();
+}
+
+/* PDF threshold accessor */
+void QuantileMeasure::setPDFThreshold(const Scalar threshold)
+{
+  MeasureEvaluationImplementation::setPDFThreshold(threshold);
+  lastBracket_.clear();
+}
+
 /* Alpha coefficient accessor */
 void QuantileMeasure::setAlpha(const Scalar alpha)
 {
   if (!(alpha >= 0.0) || !(alpha <= 1.0))
     throw InvalidArgumentException(HERE) << "Alpha should be in (0, 1)";
   alpha_ = alpha;
+  lastBracket_.clear();
 }
 
 Scalar QuantileMeasure::getAlpha() const
@@ -307,6 +578,20 @@ Scalar QuantileMeasure::getAlpha() const
   return alpha_;
 }
 
+/* Single sweep accessor */
+void QuantileMeasure::setSingleSweep(const Bool singleSweep)
+{
+  singleSweep_ = singleSweep;
+  // The adaptive algorithms are replaced by a fixed rule whose nodes are computed once
+  setSweepNodesNumber(singleSweep_ ? ResourceMap::GetAsUnsignedInteger("QuantileMeasure-SingleSweepNodesNumber") : 0);
+  lastBracket_.clear();
+}
+
+Bool QuantileMeasure::getSingleSweep() const
+{
+  return singleSweep_;
+}
+
 /* String converter */
 String QuantileMeasure::__repr__() const
 {
@@ -321,6 +606,7 @@ void QuantileMeasure::save(Advocate & adv) const
 {
   MeasureEvaluationImplementation::save(adv);
   adv.saveAttribute("alpha_", alpha_);
+  adv.saveAttribute("singleSweep_", singleSweep_);
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -328,6 +614,11 @@ void QuantileMeasure::load(Advocate & adv)
 {
   MeasureEvaluationImplementation::load(adv);
   adv.loadAttribute("alpha_", alpha_);
+  if (adv.hasAttribute("singleSweep_"))
+    adv.loadAttribute("singleSweep_", singleSweep_);
+  // The number of sweep nodes is restored by the base class, older studies take it from the ResourceMap
+  if (!adv.hasAttribute("sweepNodesNumber_"))
+    setSingleSweep(singleSweep_);
 }
 
 
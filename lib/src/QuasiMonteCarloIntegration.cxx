@@ -0,0 +1,270 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Randomized quasi-Monte Carlo integration
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/QuasiMonteCarloIntegration.hxx"
+#include <openturns/PersistentObjectFactory.hxx>
+#include <openturns/ResourceMap.hxx>
+#include <openturns/RandomGenerator.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <openturns/Uniform.hxx>
+#include <openturns/JointDistribution.hxx>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+CLASSNAMEINIT(QuasiMonteCarloIntegration)
+
+static Factory<QuasiMonteCarloIntegration> Factory_QuasiMonteCarloIntegration;
+
+
+/* Default constructor */
+QuasiMonteCarloIntegration::QuasiMonteCarloIntegration()
+  : IntegrationAlgorithmImplementation()
+  , size_(ResourceMap::GetAsUnsignedInteger("QuasiMonteCarloIntegration-DefaultSize"))
+  , replicationsNumber_(ResourceMap::GetAsUnsignedInteger("QuasiMonteCarloIntegration-DefaultReplicationsNumber"))
+  , sequence_(SobolSequence())
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+QuasiMonteCarloIntegration::QuasiMonteCarloIntegration(const UnsignedInteger size,
+    const LowDiscrepancySequence & sequence)
+  : IntegrationAlgorithmImplementation()
+  , replicationsNumber_(ResourceMap::GetAsUnsignedInteger("QuasiMonteCarloIntegration-DefaultReplicationsNumber"))
+  , sequence_(sequence)
+{
+  setSize(size);
+}
+
+/* Virtual constructor method */
+QuasiMonteCarloIntegration * QuasiMonteCarloIntegration::clone() const
+{
+  return new QuasiMonteCarloIntegration(*this);
+}
+
+
+/* Compute an approximation of the integral of the function over the interval */
+Point QuasiMonteCarloIntegration::integrate(const Function & function,
+    const Interval & interval) const
+{
+  Point error;
+  return integrate(function, interval, error);
+}
+
+/* Same, with the standard deviation of the estimate over the replications */
+Point QuasiMonteCarloIntegration::integrate(const Function & function,
+    const Interval & interval,
+    Point & error) const
+{
+  if (function.getInputDimension() != interval.getDimension())
+    throw InvalidArgumentException(HERE) << "Error: the function input dimension (" << function.getInputDimension() << ") does not match the interval dimension (" << interval.getDimension() << ")";
+  Point weights;
+  const Sample nodes(generateWithWeights(interval, weights));
+  const Sample values(function(nodes));
+  // The replications are consecutive blocks of nodes
+  const UnsignedInteger outputDimension = function.getOutputDimension();
+  const UnsignedInteger nodesNumber = nodes.getSize() / replicationsNumber_;
+  Sample estimates(replicationsNumber_, outputDimension);
+  for (UnsignedInteger r = 0; r < replicationsNumber_; ++ r)
+    for (UnsignedInteger i = r * nodesNumber; i < (r + 1) * nodesNumber; ++ i)
+    {
+      if (!(weights[i] > 0.0)) continue;
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        estimates(r, j) += replicationsNumber_ * weights[i] * values(i, j);
+    }
+  error = Point(outputDimension);
+  if (replicationsNumber_ > 1)
+  {
+    const Point variance(estimates.computeVariance());
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      error[j] = std::sqrt(variance[j] / replicationsNumber_);
+  }
+  return estimates.computeMean();
+}
+
+/* Nodes of all the replications and their weights in the estimate of the integral */
+Sample QuasiMonteCarloIntegration::generateWithWeights(const Interval & interval,
+    Point & weights) const
+{
+  const UnsignedInteger dimension = interval.getDimension();
+  Distribution distribution(distribution_);
+  if (!hasDistribution_ || (distribution.getDimension() != dimension))
+  {
+    const Point lowerBound(interval.getLowerBound());
+    const Point upperBound(interval.getUpperBound());
+    JointDistribution::DistributionCollection marginals(dimension);
+    for (UnsignedInteger j = 0; j < dimension; ++ j)
+      marginals[j] = Uniform(lowerBound[j], upperBound[j]);
+    distribution = JointDistribution(marginals);
+  }
+  // Shifts not drawn for this dimension yet make the estimate random
+  const Sample shifts((shifts_.getSize() == replicationsNumber_) && (shifts_.getDimension() == dimension) ? shifts_ : DrawShifts(replicationsNumber_, dimension));
+  const UnsignedInteger nodesNumber = std::max<UnsignedInteger>(1, size_ / replicationsNumber_);
+  LowDiscrepancySequence sequence(sequence_);
+  sequence.initialize(dimension);
+  const Sample base(sequence.generate(nodesNumber));
+  Sample uniform(replicationsNumber_ * nodesNumber, dimension);
+  for (UnsignedInteger r = 0; r < replicationsNumber_; ++ r)
+    for (UnsignedInteger i = 0; i < nodesNumber; ++ i)
+      for (UnsignedInteger j = 0; j < dimension; ++ j)
+      {
+        Scalar u = base(i, j) + shifts(r, j);
+        u -= std::floor(u);
+        uniform(r * nodesNumber + i, j) = std::min(std::max(u, SpecFunc::ScalarEpsilon), 1.0 - SpecFunc::ScalarEpsilon);
+      }
+  const Sample nodes(ComputeNodes(distribution, uniform));
+  // The integrand is divided by the density the nodes are drawn from
+  const Sample pdf(distribution.computePDF(nodes));
+  const UnsignedInteger size = nodes.getSize();
+  weights = Point(size);
+  for (UnsignedInteger i = 0; i < size; ++ i)
+    if ((pdf(i, 0) > 0.0) && interval.contains(nodes[i]))
+      weights[i] = 1.0 / (size * pdf(i, 0));
+  return nodes;
+}
+
+/* Map points of the unit cube to the distribution */
+Sample QuasiMonteCarloIntegration::ComputeNodes(const Distribution & distribution,
+    const Sample & uniform)
+{
+  const UnsignedInteger size = uniform.getSize();
+  const UnsignedInteger dimension = uniform.getDimension();
+  // Marginal quantiles when the components are independent, else through the standard space
+  const Bool independent = distribution.hasIndependentCopula();
+  const Distribution marginalSource(independent ? distribution : distribution.getStandardDistribution());
+  Sample nodes(size, dimension);
+  for (UnsignedInteger j = 0; j < dimension; ++ j)
+  {
+    const Distribution marginal(marginalSource.getMarginal(j));
+    for (UnsignedInteger i = 0; i < size; ++ i)
+      nodes(i, j) = marginal.computeQuantile(uniform(i, j))[0];
+  }
+  if (independent) return nodes;
+  return distribution.getInverseIsoProbabilisticTransformation()(nodes);
+}
+
+/* Draw the shifts of the replications */
+Sample QuasiMonteCarloIntegration::DrawShifts(const UnsignedInteger replicationsNumber,
+    const UnsignedInteger dimension)
+{
+  Sample shifts(replicationsNumber, dimension);
+  // A single replication is the plain deterministic sequence
+  if (replicationsNumber < 2) return shifts;
+  for (UnsignedInteger r = 0; r < replicationsNumber; ++ r)
+    shifts[r] = RandomGenerator::Generate(dimension);
+  return shifts;
+}
+
+
+/* Total number of nodes accessor */
+void QuasiMonteCarloIntegration::setSize(const UnsignedInteger size)
+{
+  if (size == 0) throw InvalidArgumentException(HERE) << "The number of nodes must be positive";
+  size_ = size;
+}
+
+UnsignedInteger QuasiMonteCarloIntegration::getSize() const
+{
+  return size_;
+}
+
+/* Number of randomly shifted replications accessor */
+void QuasiMonteCarloIntegration::setReplicationsNumber(const UnsignedInteger replicationsNumber)
+{
+  if (replicationsNumber == 0) throw InvalidArgumentException(HERE) << "The number of replications must be positive";
+  replicationsNumber_ = replicationsNumber;
+  if (hasDistribution_) shifts_ = DrawShifts(replicationsNumber_, distribution_.getDimension());
+}
+
+UnsignedInteger QuasiMonteCarloIntegration::getReplicationsNumber() const
+{
+  return replicationsNumber_;
+}
+
+/* Low discrepancy sequence accessor */
+void QuasiMonteCarloIntegration::setSequence(const LowDiscrepancySequence & sequence)
+{
+  sequence_ = sequence;
+}
+
+LowDiscrepancySequence QuasiMonteCarloIntegration::getSequence() const
+{
+  return sequence_;
+}
+
+/* Distribution of the nodes accessor */
+void QuasiMonteCarloIntegration::setDistribution(const Distribution & distribution)
+{
+  distribution_ = distribution;
+  hasDistribution_ = true;
+  shifts_ = DrawShifts(replicationsNumber_, distribution_.getDimension());
+}
+
+Distribution QuasiMonteCarloIntegration::getDistribution() const
+{
+  return distribution_;
+}
+
+Bool QuasiMonteCarloIntegration::hasDistribution() const
+{
+  return hasDistribution_;
+}
+
+
+/* String converter */
+String QuasiMonteCarloIntegration::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << QuasiMonteCarloIntegration::GetClassName()
+      << " size=" << size_
+      << " replicationsNumber=" << replicationsNumber_
+      << " sequence=" << sequence_;
+  if (hasDistribution_) oss << " distribution=" << distribution_;
+  return oss;
+}
+
+/* Method save() stores the object through the StorageManager */
+void QuasiMonteCarloIntegration::save(Advocate & adv) const
+{
+  IntegrationAlgorithmImplementation::save(adv);
+  adv.saveAttribute("size_", size_);
+  adv.saveAttribute("replicationsNumber_", replicationsNumber_);
+  adv.saveAttribute("sequence_", sequence_);
+  adv.saveAttribute("distribution_", distribution_);
+  adv.saveAttribute("hasDistribution_", hasDistribution_);
+  adv.saveAttribute("shifts_", shifts_);
+}
+
+/* Method load() reloads the object from the StorageManager */
+void QuasiMonteCarloIntegration::load(Advocate & adv)
+{
+  IntegrationAlgorithmImplementation::load(adv);
+  adv.loadAttribute("size_", size_);
+  adv.loadAttribute("replicationsNumber_", replicationsNumber_);
+  adv.loadAttribute("sequence_", sequence_);
+  adv.loadAttribute("distribution_", distribution_);
+  adv.loadAttribute("hasDistribution_", hasDistribution_);
+  adv.loadAttribute("shifts_", shifts_);
+}
+
+} /* namespace OTROBOPT */
@@ -21,7 +21,7 @@
 #include "otrobopt/RobustOptimizationProblem.hxx"
 #include <otrobopt/MeasureEvaluationImplementation.hxx>
 #include <openturns/PersistentObjectFactory.hxx>
-#include <openturns/FunctionImplementation.hxx>
+#include <otrobopt/MeasureFunction.hxx>
 
 using namespace OT;
 
@@ -44,10 +44,10 @@ RobustOptimizationProblem::RobustOptimizationProblem(const MeasureEvaluation & r
     const MeasureEvaluation & reliabilityMeasure)
   : OptimizationProblemImplementation()
 {
-  setRobustnessMeasure(robustnessMeasure);
-  setReliabilityMeasure(reliabilityMeasure);
   if (robustnessMeasure.getDistribution() != reliabilityMeasure.getDistribution())
     throw InvalidArgumentException(HERE) << "Different measure distributions for objective and constraint";
+  setRobustnessMeasure(robustnessMeasure);
+  setReliabilityMeasure(reliabilityMeasure);
 }
 
 RobustOptimizationProblem::RobustOptimizationProblem(const Function & objective,
@@ -87,7 +87,8 @@ String RobustOptimizationProblem::__repr__() const
 void RobustOptimizationProblem::setRobustnessMeasure(const MeasureEvaluation & robustnessMeasure)
 {
   robustnessMeasure_ = robustnessMeasure;
-  setObjective(FunctionImplementation(Evaluation(robustnessMeasure.getImplementation())));
+  setObjective(MeasureFunction(robustnessMeasure));
+  shareEvaluations();
 }
 
 MeasureEvaluation RobustOptimizationProblem::getRobustnessMeasure() const
@@ -104,7 +105,8 @@ Bool RobustOptimizationProblem::hasRobustnessMeasure() const
 void RobustOptimizationProblem::setReliabilityMeasure(const MeasureEvaluation & reliabilityMeasure)
 {
   reliabilityMeasure_ = reliabilityMeasure;
-  setInequalityConstraint(FunctionImplementation(Evaluation(reliabilityMeasure.getImplementation())));
+  setInequalityConstraint(MeasureFunction(reliabilityMeasure));
+  shareEvaluations();
 }
 
 MeasureEvaluation RobustOptimizationProblem::getReliabilityMeasure() const
@@ -118,6 +120,24 @@ Bool RobustOptimizationProblem::hasReliabilityMeasure() const
   return reliabilityMeasure_.getFunction().getInputDimension() > 0;
 }
 
+/* Feed the objective and the constraint from the same evaluations of the function */
+void RobustOptimizationProblem::shareEvaluations()
+{
+  if (!hasRobustnessMeasure() || !hasReliabilityMeasure()) return;
+  // Solvers request both at the same x: once one measure has swept the nodes,
+  // the values and gradients are cache hits for the other one.
+  // Only the measures reduced over the same fixed nodes can share them
+  Collection<MeasureEvaluation> measures(2);
+  measures[0] = robustnessMeasure_;
+  measures[1] = reliabilityMeasure_;
+  MeasureEvaluationCache::Share(measures);
+  if (!measures[0].getEvaluationCache().isEnabled()) return;
+  robustnessMeasure_ = measures[0];
+  reliabilityMeasure_ = measures[1];
+  setObjective(MeasureFunction(robustnessMeasure_));
+  setInequalityConstraint(MeasureFunction(reliabilityMeasure_));
+}
+
 Distribution RobustOptimizationProblem::getDistribution() const
 {
   Distribution distributionXi;
@@ -142,6 +162,7 @@ void RobustOptimizationProblem::load(Advocate & adv)
   OptimizationProblemImplementation::load(adv);
   adv.loadAttribute("robustnessMeasure_", robustnessMeasure_);
   adv.loadAttribute("reliabilityMeasure_", reliabilityMeasure_);
+  shareEvaluations();
 }
 
 
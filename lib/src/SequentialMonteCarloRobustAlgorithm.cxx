@@ -20,6 +20,7 @@
  */
 #include "otrobopt/SequentialMonteCarloRobustAlgorithm.hxx"
 #include <otrobopt/MeasureFactory.hxx>
+#include <otrobopt/MeasureFunction.hxx>
 
 #include <openturns/PersistentObjectFactory.hxx>
 #include <openturns/FixedExperiment.hxx>
@@ -110,22 +111,34 @@ void SequentialMonteCarloRobustAlgorithm::run()
 
     OptimizationProblem problem(getProblem());
 
-    if (robustProblem.hasRobustnessMeasure())
+    const FixedExperiment experiment(currentSampleXi);
+    const MeasureFactory factory(experiment);
+    if (robustProblem.hasRobustnessMeasure() && robustProblem.hasReliabilityMeasure()
+        && (robustProblem.getRobustnessMeasure().getDistribution() == robustProblem.getReliabilityMeasure().getDistribution()))
     {
-      // discretize the robustness measure
-      const FixedExperiment experiment(currentSampleXi);
-      const MeasureFactory robustnessFactory(experiment);
-      MeasureEvaluation rhoJ = robustnessFactory.build(robustProblem.getRobustnessMeasure());
-      problem.setObjective(*rhoJ.getImplementation());
+      // discretize both measures on the same nodes, so that they share the
+      // evaluations of the function when they are built on the same one
+      Collection<MeasureEvaluation> measures(2);
+      measures[0] = robustProblem.getRobustnessMeasure();
+      measures[1] = robustProblem.getReliabilityMeasure();
+      measures = factory.buildCollection(measures);
+      problem.setObjective(MeasureFunction(measures[0]));
+      problem.setInequalityConstraint(MeasureFunction(measures[1]));
     }
-
-    if (robustProblem.hasReliabilityMeasure())
+    else
     {
-      // discretize the reliability measure
-      const FixedExperiment experiment(currentSampleXi);
-      const MeasureFactory reliabilityFactory(experiment);
-      MeasureEvaluation pG(reliabilityFactory.build(robustProblem.getReliabilityMeasure()));
-      problem.setInequalityConstraint(*pG.getImplementation());
+      if (robustProblem.hasRobustnessMeasure())
+      {
+        // discretize the robustness measure
+        MeasureEvaluation rhoJ = factory.build(robustProblem.getRobustnessMeasure());
+        problem.setObjective(MeasureFunction(rhoJ));
+      }
+      if (robustProblem.hasReliabilityMeasure())
+      {
+        // discretize the reliability measure
+        MeasureEvaluation pG(factory.build(robustProblem.getReliabilityMeasure()));
+        problem.setInequalityConstraint(MeasureFunction(pG));
+      }
     }
 
     OptimizationAlgorithm solver(solver_);
@@ -0,0 +1,329 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Dimension-adaptive Smolyak sparse grid integration
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "otrobopt/SparseGridIntegration.hxx"
+#include <openturns/PersistentObjectFactory.hxx>
+#include <openturns/ResourceMap.hxx>
+#include <openturns/SpecFunc.hxx>
+
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace OT;
+
+namespace OTROBOPT
+{
+
+CLASSNAMEINIT(SparseGridIntegration)
+
+static Factory<SparseGridIntegration> Factory_SparseGridIntegration;
+
+typedef std::vector<UnsignedInteger> MultiIndex;
+
+/* Clenshaw-Curtis rule of the given level on [0, 1], with 1 node at level 0 and
+   2^level+1 nodes above. The keys locate the nodes on the finest level, so that
+   a node shared by several levels has the same key */
+static void ComputeClenshawCurtisRule(const UnsignedInteger level,
+                                      const UnsignedInteger maximumLevel,
+                                      Point & nodes,
+                                      Point & weights,
+                                      Indices & keys)
+{
+  if (level == 0)
+  {
+    nodes = Point(1, 0.5);
+    weights = Point(1, 1.0);
+    keys = Indices(1, 1UL << (maximumLevel - 1));
+    return;
+  }
+  const UnsignedInteger n = 1UL << level;
+  nodes = Point(n + 1);
+  weights = Point(n + 1);
+  keys = Indices(n + 1);
+  for (UnsignedInteger j = 0; j <= n; ++ j)
+  {
+    const Scalar theta = SpecFunc::PI * j / n;
+    nodes[j] = 0.5 * (1.0 - std::cos(theta));
+    Scalar sum = 0.0;
+    for (UnsignedInteger k = 1; k <= n / 2; ++ k)
+      sum += (2 * k == n ? 1.0 : 2.0) / (4.0 * k * k - 1.0) * std::cos(2.0 * k * theta);
+    // Halved for the unit interval
+    weights[j] = 0.5 * ((j == 0) || (j == n) ? 1.0 : 2.0) / n * (1.0 - sum);
+    keys[j] = j << (maximumLevel - level);
+  }
+}
+
+
+/* Default constructor */
+SparseGridIntegration::SparseGridIntegration()
+  : IntegrationAlgorithmImplementation()
+  , maximumError_(ResourceMap::GetAsScalar("SparseGridIntegration-DefaultMaximumError"))
+  , maximumCallsNumber_(ResourceMap::GetAsUnsignedInteger("SparseGridIntegration-DefaultMaximumCallsNumber"))
+  , maximumLevel_(ResourceMap::GetAsUnsignedInteger("SparseGridIntegration-DefaultMaximumLevel"))
+{
+  // Nothing to do
+}
+
+/* Parameter constructor */
+SparseGridIntegration::SparseGridIntegration(const Scalar maximumError)
+  : IntegrationAlgorithmImplementation()
+  , maximumCallsNumber_(ResourceMap::GetAsUnsignedInteger("SparseGridIntegration-DefaultMaximumCallsNumber"))
+  , maximumLevel_(ResourceMap::GetAsUnsignedInteger("SparseGridIntegration-DefaultMaximumLevel"))
+{
+  setMaximumError(maximumError);
+}
+
+/* Virtual constructor method */
+SparseGridIntegration * SparseGridIntegration::clone() const
+{
+  return new SparseGridIntegration(*this);
+}
+
+
+/* Compute an approximation of the integral of the function over the interval */
+Point SparseGridIntegration::integrate(const Function & function,
+                                       const Interval & interval) const
+{
+  Point error;
+  return integrate(function, interval, error);
+}
+
+/* Same, with the sum of the contributions of the indices not refined yet */
+Point SparseGridIntegration::integrate(const Function & function,
+                                       const Interval & interval,
+                                       Point & error) const
+{
+  const UnsignedInteger dimension = interval.getDimension();
+  if (function.getInputDimension() != dimension)
+    throw InvalidArgumentException(HERE) << "Error: the function input dimension (" << function.getInputDimension() << ") does not match the interval dimension (" << dimension << ")";
+  const UnsignedInteger outputDimension = function.getOutputDimension();
+  const Point lowerBound(interval.getLowerBound());
+  const Point delta(interval.getUpperBound() - lowerBound);
+  Scalar volume = 1.0;
+  for (UnsignedInteger i = 0; i < dimension; ++ i)
+    volume *= delta[i];
+
+  // One-dimensional rules, the weights being the ones of the difference
+  // with the previous level on the nodes of the current one
+  Collection<Point> ruleNodes(maximumLevel_ + 1);
+  Collection<Point> ruleWeights(maximumLevel_ + 1);
+  Collection<Indices> ruleKeys(maximumLevel_ + 1);
+  Point previousWeights;
+  for (UnsignedInteger level = 0; level <= maximumLevel_; ++ level)
+  {
+    ComputeClenshawCurtisRule(level, maximumLevel_, ruleNodes[level], ruleWeights[level], ruleKeys[level]);
+    const Point weights(ruleWeights[level]);
+    // The nodes of the previous level are the middle one, then the even ones
+    for (UnsignedInteger j = 0; j < previousWeights.getSize(); ++ j)
+      ruleWeights[level][level == 1 ? 1 : 2 * j] -= previousWeights[j];
+    previousWeights = weights;
+  }
+
+  // Values of the integrand by node keys, each node being evaluated once
+  std::map<MultiIndex, UnsignedInteger> known;
+  Sample values(0, outputDimension);
+
+  // Contribution of the tensor product of the one-dimensional differences
+  Point contribution(outputDimension);
+  Bool exhausted = false;
+  auto computeContribution = [&](const MultiIndex & index) -> Bool
+  {
+    UnsignedInteger size = 1;
+    for (UnsignedInteger i = 0; i < dimension; ++ i)
+      size *= ruleNodes[index[i]].getSize();
+    if (known.size() + size > maximumCallsNumber_) return false;
+    Indices rows(size);
+    Point weights(size, volume);
+    Sample newNodes(0, dimension);
+    Indices position(dimension, 0);
+    MultiIndex key(dimension);
+    Point node(dimension);
+    for (UnsignedInteger p = 0; p < size; ++ p)
+    {
+      for (UnsignedInteger i = 0; i < dimension; ++ i)
+      {
+        key[i] = ruleKeys[index[i]][position[i]];
+        weights[p] *= ruleWeights[index[i]][position[i]];
+      }
+      const std::map<MultiIndex, UnsignedInteger>::const_iterator it = known.find(key);
+      if (it != known.end())
+        rows[p] = it->second;
+      else
+      {
+        for (UnsignedInteger i = 0; i < dimension; ++ i)
+          node[i] = lowerBound[i] + delta[i] * ruleNodes[index[i]][position[i]];
+        rows[p] = values.getSize() + newNodes.getSize();
+        known[key] = rows[p];
+        newNodes.add(node);
+      }
+      // Next node of the tensor grid
+      for (UnsignedInteger i = 0; i < dimension; ++ i)
+      {
+        ++ position[i];
+        if (position[i] < ruleNodes[index[i]].getSize()) break;
+        position[i] = 0;
+      }
+    }
+    // All the new nodes of the grid are evaluated at once
+    if (newNodes.getSize() > 0) values.add(function(newNodes));
+    contribution = Point(outputDimension);
+    for (UnsignedInteger p = 0; p < size; ++ p)
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+        contribution[j] += weights[p] * values(rows[p], j);
+    return true;
+  };
+
+  // Dimension-adaptive refinement: the active index with the largest
+  // contribution is refined in each admissible direction
+  std::set<MultiIndex> old;
+  std::map<MultiIndex, Point> active;
+  const MultiIndex root(dimension, 0);
+  computeContribution(root);
+  Point integral(contribution);
+  active[root] = contribution;
+  while (!exhausted && !active.empty())
+  {
+    error = Point(outputDimension);
+    Scalar largest = -1.0;
+    std::map<MultiIndex, Point>::iterator best = active.end();
+    for (std::map<MultiIndex, Point>::iterator it = active.begin(); it != active.end(); ++ it)
+    {
+      Scalar norm = 0.0;
+      for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      {
+        error[j] += std::abs(it->second[j]);
+        norm = std::max(norm, std::abs(it->second[j]));
+      }
+      if (norm > largest)
+      {
+        largest = norm;
+        best = it;
+      }
+    }
+    Scalar errorNorm = 0.0;
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      errorNorm = std::max(errorNorm, error[j]);
+    if (errorNorm <= maximumError_) break;
+    const MultiIndex index(best->first);
+    active.erase(best);
+    old.insert(index);
+    for (UnsignedInteger i = 0; (i < dimension) && !exhausted; ++ i)
+    {
+      if (index[i] == maximumLevel_) continue;
+      MultiIndex forward(index);
+      ++ forward[i];
+      // Admissible if all its backward neighbours have been refined
+      Bool admissible = true;
+      for (UnsignedInteger k = 0; (k < dimension) && admissible; ++ k)
+      {
+        if ((k == i) || (forward[k] == 0)) continue;
+        MultiIndex backward(forward);
+        -- backward[k];
+        admissible = (old.find(backward) != old.end());
+      }
+      if (!admissible) continue;
+      if (!computeContribution(forward))
+      {
+        exhausted = true;
+        break;
+      }
+      active[forward] = contribution;
+      integral += contribution;
+    }
+  }
+  error = Point(outputDimension);
+  for (std::map<MultiIndex, Point>::const_iterator it = active.begin(); it != active.end(); ++ it)
+    for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+      error[j] += std::abs(it->second[j]);
+  if (exhausted)
+    LOGWARN(OSS() << "SparseGridIntegration: the maximum number of calls (" << maximumCallsNumber_ << ") was reached with an error of " << error);
+  return integral;
+}
+
+
+/* Maximum error accessor */
+void SparseGridIntegration::setMaximumError(const Scalar maximumError)
+{
+  if (!(maximumError >= 0.0)) throw InvalidArgumentException(HERE) << "The maximum error must be nonnegative";
+  maximumError_ = maximumError;
+}
+
+Scalar SparseGridIntegration::getMaximumError() const
+{
+  return maximumError_;
+}
+
+/* Maximum number of evaluations of the integrand accessor */
+void SparseGridIntegration::setMaximumCallsNumber(const UnsignedInteger maximumCallsNumber)
+{
+  if (maximumCallsNumber == 0) throw InvalidArgumentException(HERE) << "The maximum number of calls must be positive";
+  maximumCallsNumber_ = maximumCallsNumber;
+}
+
+UnsignedInteger SparseGridIntegration::getMaximumCallsNumber() const
+{
+  return maximumCallsNumber_;
+}
+
+/* Maximum level of the one-dimensional rules accessor */
+void SparseGridIntegration::setMaximumLevel(const UnsignedInteger maximumLevel)
+{
+  // The keys of the nodes of the finest level must fit in an integer
+  if ((maximumLevel == 0) || (maximumLevel > 30)) throw InvalidArgumentException(HERE) << "The maximum level must be in [1, 30]";
+  maximumLevel_ = maximumLevel;
+}
+
+UnsignedInteger SparseGridIntegration::getMaximumLevel() const
+{
+  return maximumLevel_;
+}
+
+
+/* String converter */
+String SparseGridIntegration::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << SparseGridIntegration::GetClassName()
+      << " maximumError=" << maximumError_
+      << " maximumCallsNumber=" << maximumCallsNumber_
+      << " maximumLevel=" << maximumLevel_;
+  return oss;
+}
+
+/* Method save() stores the object through the StorageManager */
+void SparseGridIntegration::save(Advocate & adv) const
+{
+  IntegrationAlgorithmImplementation::save(adv);
+  adv.saveAttribute("maximumError_", maximumError_);
+  adv.saveAttribute("maximumCallsNumber_", maximumCallsNumber_);
+  adv.saveAttribute("maximumLevel_", maximumLevel_);
+}
+
+/* Method load() reloads the object from the StorageManager */
+void SparseGridIntegration::load(Advocate & adv)
+{
+  IntegrationAlgorithmImplementation::load(adv);
+  adv.loadAttribute("maximumError_", maximumError_);
+  adv.loadAttribute("maximumCallsNumber_", maximumCallsNumber_);
+  adv.loadAttribute("maximumLevel_", maximumLevel_);
+}
+
+} /* namespace OTROBOPT */
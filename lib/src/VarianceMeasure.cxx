@@ -23,13 +23,6 @@
 #include <openturns/GaussKronrod.hxx>
 #include <openturns/IteratedQuadrature.hxx>
 
-#if OPENTURNS_VERSION >= 102700
-#include <openturns/FiniteDiscreteDistribution.hxx>
-#else
-#include <openturns/UserDefined.hxx>
-#define FiniteDiscreteDistribution UserDefined
-#endif
-
 using namespace OT;
 
 namespace OTROBOPT
@@ -43,23 +36,24 @@ static Factory<VarianceMeasure> Factory_VarianceMeasure;
 /* Default constructor */
 VarianceMeasure::VarianceMeasure()
   : MeasureEvaluationImplementation()
+  , controlVariate_(ResourceMap::GetAsBool("VarianceMeasure-ControlVariate"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("VarianceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Parameter constructor */
 VarianceMeasure::VarianceMeasure (const Function & function,
                                   const Distribution & distribution)
   : MeasureEvaluationImplementation(function, distribution)
-
+  , controlVariate_(ResourceMap::GetAsBool("VarianceMeasure-ControlVariate"))
 {
   // Set the default integration algorithm
   GaussKronrod gkr;
   gkr.setRule(static_cast<GaussKronrodRule::GaussKronrodPair>(ResourceMap::GetAsUnsignedInteger("VarianceMeasure-GaussKronrodRule")));
-  integrationAlgorithm_ = IteratedQuadrature(gkr);
+  setIteratedQuadrature(gkr);
 }
 
 /* Virtual constructor method */
@@ -174,43 +168,100 @@ Point VarianceMeasure::operator()(const Point & inP) const
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
-  if (getDistribution().isContinuous())
+  if (!hasSignificantSupport())
   {
     Pointer<FunctionImplementation> p_wrapper(new VarianceMeasureParametricFunctionWrapper(inP, function, getDistribution(), pdfThreshold_));
     const Function G(p_wrapper);
-    Point integral(integrationAlgorithm_.integrate(G, getDistribution().getRange()));
+    Point error;
+    const Point integral(computeIntegral(G, error));
+    // The error is propagated if it is known
+    Point outError(error.getDimension() > 0 ? outputDimension : 0);
     for (UnsignedInteger j = 0; j < outputDimension; ++ j)
     {
       const Scalar mean = integral[j];
       // Var(f(x))=\mathbb{E}(f^2(x))-\mathbb{E}(f(x))^2
       outP[j] = integral[outputDimension + j] - mean * mean;
+      if (outError.getDimension() > 0) outError[j] = error[outputDimension + j] + 2.0 * std::abs(mean) * error[j];
     }
+    setLastError(outError);
   }
   else
   {
-    const Point pdfs(getDistribution().getProbabilities());
-    const Sample parameters(getDistribution().getSupport());
-    const UnsignedInteger size = parameters.getSize();
-    Sample values(0, outputDimension);
-    Point weights(0);
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-          weights.add(pdfs[i]);
-        }
-    } // for
-
-    // Here we use a FiniteDiscreteDistribution distribution because the algorithm
-    // to compute a central moment is quite involved in the case of
-    // nonuniform weights
-    outP = FiniteDiscreteDistribution(values, weights).getCentralMoment(2);
+    outP = reduce(inP, evaluateSignificantSupport(inP));
   } // discrete
   return outP;
 }
 
+/* Gradient: \nabla_x Var(f) = 2(\mathbb{E}(f\nabla_x f) - \mathbb{E}(f)\mathbb{E}(\nabla_x f)) */
+Matrix VarianceMeasure::gradient(const Point & inP) const
+{
+  Point mean;
+  Point variance;
+  Matrix meanGradient;
+  Matrix varianceGradient;
+  SymmetricTensor meanHessian;
+  SymmetricTensor varianceHessian;
+  computeDerivativeMoments(inP, 1, mean, variance, meanGradient, varianceGradient, meanHessian, varianceHessian);
+  return varianceGradient;
+}
+
+/* Hessian: \nabla^2_x Var(f) = 2(\mathbb{E}(\nabla_x f \nabla_x f^T) + \mathbb{E}((f - \mathbb{E}(f)) \nabla^2_x f) - \nabla_x \mathbb{E}(f) \nabla_x \mathbb{E}(f)^T) */
+SymmetricTensor VarianceMeasure::hessian(const Point & inP) const
+{
+  Point mean;
+  Point variance;
+  Matrix meanGradient;
+  Matrix varianceGradient;
+  SymmetricTensor meanHessian;
+  SymmetricTensor varianceHessian;
+  computeDerivativeMoments(inP, 2, mean, variance, meanGradient, varianceGradient, meanHessian, varianceHessian);
+  return varianceHessian;
+}
+
+/* Reduction of the function values over the retained discrete support */
+Point VarianceMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & weights) const
+{
+  // Single pass weighted moments, no need to build a discrete distribution
+  Point mean;
+  Point variance;
+  ComputeWeightedMoments(values, weights, mean, variance);
+  return variance;
+}
+
+/* With the control variate f = r + c g, where the residual r is uncorrelated with the first-order Taylor
+   expansion g on the nodes, the sampled variance c^2 Var(g) of the expansion is replaced by its exact value */
+Point VarianceMeasure::computeDiscreteMeasure(const Point & inP,
+    const Sample & values,
+    const Point & weights) const
+{
+  Point outP(computeDiscreteMeasure(values, weights));
+  if (!controlVariate_) return outP;
+  Sample expansion;
+  Point expansionMean;
+  Point expansionVariance;
+  computeTaylorExpansion(inP, expansion, expansionMean, expansionVariance);
+  Point coefficient;
+  Point controlVariance;
+  Point reduction;
+  ComputeControlVariate(values, expansion, weights, coefficient, controlVariance, reduction);
+  for (UnsignedInteger j = 0; j < outP.getDimension(); ++ j)
+    outP[j] += coefficient[j] * coefficient[j] * (expansionVariance[j] - controlVariance[j]);
+  setLastVarianceReduction(reduction);
+  return outP;
+}
+
+/* Taylor control variate accessor */
+void VarianceMeasure::setControlVariate(const Bool controlVariate)
+{
+  controlVariate_ = controlVariate;
+}
+
+Bool VarianceMeasure::getControlVariate() const
+{
+  return controlVariate_;
+}
+
 /* String converter */
 String VarianceMeasure::__repr__() const
 {
@@ -223,12 +274,15 @@ String VarianceMeasure::__repr__() const
 void VarianceMeasure::save(Advocate & adv) const
 {
   MeasureEvaluationImplementation::save(adv);
+  adv.saveAttribute("controlVariate_", controlVariate_);
 }
 
 /* Method load() reloads the object from the StorageManager */
 void VarianceMeasure::load(Advocate & adv)
 {
   MeasureEvaluationImplementation::load(adv);
+  if (adv.hasAttribute("controlVariate_"))
+    adv.loadAttribute("controlVariate_", controlVariate_);
 }
 
 
@@ -22,6 +22,11 @@
 #include <openturns/PersistentObjectFactory.hxx>
 #include <openturns/NLopt.hxx>
 #include <openturns/TNC.hxx>
+#include <openturns/LowDiscrepancyExperiment.hxx>
+#include <openturns/HaltonSequence.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <openturns/ResourceMap.hxx>
+#include <openturns/SpecFunc.hxx>
 
 using namespace OT;
 
@@ -36,6 +41,8 @@ static Factory<WorstCaseMeasure> Factory_WorstCaseMeasure;
 /* Default constructor */
 WorstCaseMeasure::WorstCaseMeasure()
   : MeasureEvaluationImplementation()
+  , startingPointsNumber_(ResourceMap::GetAsUnsignedInteger("WorstCaseMeasure-StartingPointsNumber"))
+  , warmStartCacheSize_(ResourceMap::GetAsUnsignedInteger("WorstCaseMeasure-WarmStartCacheSize"))
 {
   // Nothing to do
 }
@@ -47,6 +54,8 @@ WorstCaseMeasure::WorstCaseMeasure (const Function & function,
   : MeasureEvaluationImplementation(function, distribution)
   , isMinimization_(minimization)
   , solver_(new TNC())
+  , startingPointsNumber_(ResourceMap::GetAsUnsignedInteger("WorstCaseMeasure-StartingPointsNumber"))
+  , warmStartCacheSize_(ResourceMap::GetAsUnsignedInteger("WorstCaseMeasure-WarmStartCacheSize"))
 {
   // Nothing to do
 }
@@ -58,6 +67,95 @@ WorstCaseMeasure * WorstCaseMeasure::clone() const
 }
 
 
+/* The mutex is not copied, each copy of the measure owns its cache */
+WorstCaseMeasure::OptimaCache::OptimaCache()
+{
+  // Nothing to do
+}
+
+WorstCaseMeasure::OptimaCache::OptimaCache(const OptimaCache & other)
+{
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  points_ = other.points_;
+  optima_ = other.optima_;
+  next_ = other.next_;
+}
+
+WorstCaseMeasure::OptimaCache & WorstCaseMeasure::OptimaCache::operator =(const OptimaCache & other)
+{
+  if (this != &other)
+  {
+    std::lock(mutex_, other.mutex_);
+    std::lock_guard<std::mutex> lock(mutex_, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other.mutex_, std::adopt_lock);
+    points_ = other.points_;
+    optima_ = other.optima_;
+    next_ = other.next_;
+  }
+  return *this;
+}
+
+Bool WorstCaseMeasure::OptimaCache::find(const Point & x,
+    Sample & optima) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const UnsignedInteger size = points_.getSize();
+  if (size == 0) return false;
+  UnsignedInteger nearest = 0;
+  Scalar nearestDistance = SpecFunc::MaxScalar;
+  for (UnsignedInteger i = 0; i < size; ++ i)
+  {
+    const Scalar distance = (points_[i] - x).normSquare();
+    if (distance < nearestDistance)
+    {
+      nearest = i;
+      nearestDistance = distance;
+    }
+  }
+  optima = optima_[nearest];
+  return true;
+}
+
+Bool WorstCaseMeasure::OptimaCache::lookup(const Point & x,
+    Sample & optima) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (UnsignedInteger i = 0; i < points_.getSize(); ++ i)
+    if (points_[i] == x)
+    {
+      optima = optima_[i];
+      return true;
+    }
+  return false;
+}
+
+void WorstCaseMeasure::OptimaCache::add(const Point & x,
+    const Sample & optima,
+    const UnsignedInteger maximumSize)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (points_.getSize() < maximumSize)
+  {
+    points_.add(x);
+    optima_.add(optima);
+    return;
+  }
+  // Replace the oldest entry
+  next_ = next_ % maximumSize;
+  points_[next_] = x;
+  optima_[next_] = optima;
+  ++ next_;
+}
+
+void WorstCaseMeasure::OptimaCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  points_.clear();
+  optima_.clear();
+  next_ = 0;
+}
+
+
 class WorstCaseMeasureParametricFunctionWrapper : public FunctionImplementation
 {
 public:
@@ -193,12 +291,115 @@ protected:
 
 
 
+/* Inner optimization for each (marginal, starting point) pair, possibly in parallel.
+   Each task writes its own slot of the optimal values, the best one per marginal
+   is selected afterwards so the result does not depend on the scheduling */
+struct WorstCaseMeasurePolicy
+{
+  const Point & x_;
+  const Function & function_;
+  const Function & constraint_;
+  const Interval & bounds_;
+  const Sample & startingPoints_;
+  const Sample & warmStarts_;
+  const OptimizationAlgorithm & solver_;
+  const Bool isMinimization_;
+  Sample & optimalValues_;
+  Sample & optimalPoints_;
+
+  WorstCaseMeasurePolicy(const Point & x,
+                         const Function & function,
+                         const Function & constraint,
+                         const Interval & bounds,
+                         const Sample & startingPoints,
+                         const Sample & warmStarts,
+                         const OptimizationAlgorithm & solver,
+                         const Bool isMinimization,
+                         Sample & optimalValues,
+                         Sample & optimalPoints)
+    : x_(x)
+    , function_(function)
+    , constraint_(constraint)
+    , bounds_(bounds)
+    , startingPoints_(startingPoints)
+    , warmStarts_(warmStarts)
+    , solver_(solver)
+    , isMinimization_(isMinimization)
+    , optimalValues_(optimalValues)
+    , optimalPoints_(optimalPoints)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger startingPointsNumber = startingPoints_.getSize();
+    const UnsignedInteger outputDimension = optimalValues_.getDimension();
+    for (UnsignedInteger k = r.begin(); k != r.end(); ++ k)
+    {
+      const UnsignedInteger j = k / startingPointsNumber;
+      const UnsignedInteger s = k % startingPointsNumber;
+      const Pointer<FunctionImplementation> p_wrapper(new WorstCaseMeasureParametricFunctionWrapper(x_, function_.getMarginal(j)));
+      const Function G(p_wrapper);
+      OptimizationProblem problem(G, Function(), constraint_, bounds_);
+      problem.setMinimization(isMinimization_);
+      OptimizationAlgorithm solver(solver_);
+      // The first start of each marginal is its warm start if any
+      solver.setStartingPoint((s == 0) && (warmStarts_.getSize() > 0) ? Point(warmStarts_[j]) : Point(startingPoints_[s]));
+      solver.setProblem(problem);
+      solver.run();
+      const OptimizationResult result(solver.getResult());
+      optimalValues_(s, j) = result.getOptimalValue()[0];
+      optimalPoints_[s * outputDimension + j] = result.getOptimalPoint();
+    } // k
+  }
+}; /* end struct WorstCaseMeasurePolicy */
+
+
 /* Evaluation */
 Point WorstCaseMeasure::operator()(const Point & inP) const
+{
+  Sample optima;
+  return computeOptima(inP, optima);
+}
+
+/* The worst case over a continuous distribution is searched by the inner optimization
+   at each design point, even when the integration algorithm provides fixed nodes */
+Sample WorstCaseMeasure::operator()(const Sample & inS) const
+{
+  if (!distribution_.isContinuous()) return MeasureEvaluationImplementation::operator()(inS);
+  return EvaluationImplementation::operator()(inS);
+}
+
+/* Gradient.
+   By the envelope theorem the gradient of x -> f(x, \theta^*(x)) is \nabla_x f(x, \theta^*)
+   at a regular optimum, so there is no need to differentiate the inner optimization */
+Matrix WorstCaseMeasure::gradient(const Point & inP) const
+{
+  Sample optima;
+  // The optimum is usually known from the evaluation at the same point
+  if (!lastOptima_.lookup(inP, optima))
+    computeOptima(inP, optima);
+  Function function(getFunction());
+  const UnsignedInteger inputDimension = function.getInputDimension();
+  const UnsignedInteger outputDimension = function.getOutputDimension();
+  Matrix result(inputDimension, outputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
+  {
+    function.setParameter(optima[j]);
+    const Matrix gradient(function.gradient(inP));
+    for (UnsignedInteger i = 0; i < inputDimension; ++ i)
+      result(i, j) = gradient(i, j);
+  }
+  return result;
+}
+
+/* Worst-case values and the parameters reaching them for each marginal */
+Point WorstCaseMeasure::computeOptima(const Point & inP,
+                                      Sample & optima) const
 {
   Function function(getFunction());
   const UnsignedInteger outputDimension = function.getOutputDimension();
   Point outP(outputDimension);
+  optima = Sample(outputDimension, distribution_.getDimension());
   if (distribution_.isContinuous())
   {
     Function C;
@@ -207,43 +408,112 @@ Point WorstCaseMeasure::operator()(const Point & inP) const
         const Pointer<FunctionImplementation> p_wrapper(new WorstCaseMeasureLogPDFWrapper(distribution_, std::log(pdfThreshold_)));
         C = Function(p_wrapper);
       }
+    // The first start is the mean, the others cover the distribution with a
+    // deterministic low discrepancy design so the measure stays a function of x
+    Sample startingPoints(1, distribution_.getMean());
+    if (startingPointsNumber_ > 1)
+      startingPoints.add(LowDiscrepancyExperiment(HaltonSequence(), distribution_, startingPointsNumber_ - 1).generate());
+    const UnsignedInteger startingSize = startingPoints.getSize();
+    const Interval bounds(distribution_.getRange());
+    // Start from the optimal parameters found at the nearest cached design point
+    Sample warmStarts;
+    if (warmStartCacheSize_ > 0)
+    {
+      if (!warmStartCache_.find(inP, warmStarts) || (warmStarts.getSize() != outputDimension)) warmStarts = Sample();
+      for (UnsignedInteger j = 0; j < warmStarts.getSize(); ++ j)
+        if (!bounds.contains(warmStarts[j])) warmStarts[j] = distribution_.getMean();
+    }
+    Sample optimalValues(startingSize, outputDimension);
+    Sample optimalPoints(startingSize * outputDimension, distribution_.getDimension());
+    const WorstCaseMeasurePolicy policy(inP, function, C, bounds, startingPoints, warmStarts, solver_, isMinimization(), optimalValues, optimalPoints);
+    const UnsignedInteger size = outputDimension * startingSize;
+    if ((size > 1) && function.getEvaluation().getImplementation()->isParallel())
+      TBBImplementation::ParallelFor(0, size, policy);
+    else
+      policy(TBBImplementation::BlockedRange<UnsignedInteger>(0, size));
+    // Retain the best start of each marginal
     for (UnsignedInteger j = 0; j < outputDimension; ++ j)
     {
-      const Pointer<FunctionImplementation> p_wrapper(new WorstCaseMeasureParametricFunctionWrapper(inP, function.getMarginal(j)));
-      const Function G(p_wrapper);
-      OptimizationProblem problem(G, Function(), C, distribution_.getRange());
-      problem.setMinimization(isMinimization());
-      OptimizationAlgorithm solver(solver_);
-      solver.setStartingPoint(distribution_.getMean());
-      solver.setProblem(problem);
-      solver.run();
-      const Point optimalValue(solver.getResult().getOptimalValue());
-      outP[j] = optimalValue[0];
-    } // j
+      UnsignedInteger best = 0;
+      for (UnsignedInteger s = 1; s < startingSize; ++ s)
+        if (isMinimization() ? (optimalValues(s, j) < optimalValues(best, j)) : (optimalValues(s, j) > optimalValues(best, j)))
+          best = s;
+      outP[j] = optimalValues(best, j);
+      optima[j] = optimalPoints[best * outputDimension + j];
+    }
+    if (warmStartCacheSize_ > 0) warmStartCache_.add(inP, optima, warmStartCacheSize_);
   }
   else
+    outP = computeDiscreteOptima(evaluateSignificantSupport(inP), optima);
+  lastOptima_.add(inP, optima, 1);
+  return outP;
+}
+
+/* Extremal values over the significant support and the nodes reaching them for each marginal */
+Point WorstCaseMeasure::computeDiscreteOptima(const Sample & values,
+    Sample & optima) const
+{
+  const Sample & parameters(getSignificantSupport());
+  const UnsignedInteger outputDimension = values.getDimension();
+  Point outP(outputDimension);
+  optima = Sample(outputDimension, parameters.getDimension());
+  for (UnsignedInteger j = 0; j < outputDimension; ++ j)
   {
-    const Point pdfs(distribution_.getProbabilities());
-    const Sample parameters(distribution_.getSupport());
-    const UnsignedInteger size = pdfs.getSize();
-    Sample values(0, outputDimension);
-    for (UnsignedInteger i = 0; i < size; ++i)
-    {
-      if (pdfs[i] > pdfThreshold_)
-        {
-          function.setParameter(parameters[i]);
-          values.add(function(inP));
-        }
-    } // i
-    outP = (isMinimization_ ? values.getMin() : values.getMax());
-  } // discrete
+    UnsignedInteger best = 0;
+    for (UnsignedInteger k = 1; k < values.getSize(); ++ k)
+      if (isMinimization() ? (values(k, j) < values(best, j)) : (values(k, j) > values(best, j)))
+        best = k;
+    outP[j] = values(best, j);
+    optima[j] = parameters[best];
+  }
   return outP;
 }
 
+/* Reduction of the function values over the retained discrete support */
+Point WorstCaseMeasure::computeDiscreteMeasure(const Sample & values,
+    const Point & /*weights*/) const
+{
+  return (isMinimization_ ? values.getMin() : values.getMax());
+}
+
+/* Same reduction at x, keeping the extremal nodes for the gradient */
+Point WorstCaseMeasure::reduce(const Point & inP,
+                               const Sample & values) const
+{
+  Sample optima;
+  const Point outP(computeDiscreteOptima(values, optima));
+  lastOptima_.add(inP, optima, 1);
+  return outP;
+}
+
+/* Distribution accessor */
+void WorstCaseMeasure::setDistribution(const Distribution & distribution)
+{
+  MeasureEvaluationImplementation::setDistribution(distribution);
+  warmStartCache_.clear();
+  lastOptima_.clear();
+}
+
+/* Function accessor */
+void WorstCaseMeasure::setFunction(const Function & function)
+{
+  MeasureEvaluationImplementation::setFunction(function);
+  warmStartCache_.clear();
+  lastOptima_.clear();
+}
+
+/* PDF threshold accessor */
+void WorstCaseMeasure::setPDFThreshold(const Scalar threshold)
+{
+  MeasureEvaluationImplementation::setPDFThreshold(threshold);
+  lastOptima_.clear();
+}
+
 /* Optimization solver accessor */
 void WorstCaseMeasure::setOptimizationAlgorithm(const OptimizationAlgorithm & solver)
 {
   solver_ = solver;
+  lastOptima_.clear();
 }
 
 OptimizationAlgorithm WorstCaseMeasure::getOptimizationAlgorithm() const
@@ -256,6 +526,8 @@ OptimizationAlgorithm WorstCaseMeasure::getOptimizationAlgorithm() const
 void WorstCaseMeasure::setMinimization(const Bool minimization)
 {
   isMinimization_ = minimization;
+  warmStartCache_.clear();
+  lastOptima_.clear();
 }
 
 Bool WorstCaseMeasure::isMinimization() const
@@ -263,6 +535,34 @@ Bool WorstCaseMeasure::isMinimization() const
   return isMinimization_;
 }
 
+
+/* Number of starting points of the inner optimizations accessor */
+void WorstCaseMeasure::setStartingPointsNumber(const UnsignedInteger startingPointsNumber)
+{
+  if (startingPointsNumber == 0)
+    throw InvalidArgumentException(HERE) << "The number of starting points should be positive";
+  startingPointsNumber_ = startingPointsNumber;
+  lastOptima_.clear();
+}
+
+UnsignedInteger WorstCaseMeasure::getStartingPointsNumber() const
+{
+  return startingPointsNumber_;
+}
+
+
+/* Size of the cache of warm starts of the inner optimizations accessor */
+void WorstCaseMeasure::setWarmStartCacheSize(const UnsignedInteger warmStartCacheSize)
+{
+  warmStartCacheSize_ = warmStartCacheSize;
+  warmStartCache_.clear();
+}
+
+UnsignedInteger WorstCaseMeasure::getWarmStartCacheSize() const
+{
+  return warmStartCacheSize_;
+}
+
 /* String converter */
 String WorstCaseMeasure::__repr__() const
 {
@@ -278,6 +578,8 @@ void WorstCaseMeasure::save(Advocate & adv) const
   MeasureEvaluationImplementation::save(adv);
   adv.saveAttribute("isMinimization_", isMinimization_);
   adv.saveAttribute("solver_", solver_);
+  adv.saveAttribute("startingPointsNumber_", startingPointsNumber_);
+  adv.saveAttribute("warmStartCacheSize_", warmStartCacheSize_);
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -286,6 +588,12 @@ void WorstCaseMeasure::load(Advocate & adv)
   MeasureEvaluationImplementation::load(adv);
   adv.loadAttribute("isMinimization_", isMinimization_);
   adv.loadAttribute("solver_", solver_);
+  if (adv.hasAttribute("startingPointsNumber_"))
+    adv.loadAttribute("startingPointsNumber_", startingPointsNumber_);
+  if (adv.hasAttribute("warmStartCacheSize_"))
+    adv.loadAttribute("warmStartCacheSize_", warmStartCacheSize_);
+  warmStartCache_.clear();
+  lastOptima_.clear();
 }
 
 
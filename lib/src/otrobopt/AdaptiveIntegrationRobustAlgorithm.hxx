@@ -0,0 +1,86 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Robust optimization with an integration accuracy tightened along the solver
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef OTROBOPT_ADAPTIVEINTEGRATIONROBUSTALGORITHM_HXX
+#define OTROBOPT_ADAPTIVEINTEGRATIONROBUSTALGORITHM_HXX
+
+#include "otrobopt/RobustOptimizationAlgorithm.hxx"
+
+namespace OTROBOPT
+{
+
+/**
+ * @class AdaptiveIntegrationRobustAlgorithm
+ *
+ * Successive deterministic optimization steps on the continuous measures,
+ * integrated with a coarse accuracy first and tightened as the residuals
+ * of the solver decrease, the smoothed chance measures following their
+ * bandwidth schedule
+ */
+class OTROBOPT_API AdaptiveIntegrationRobustAlgorithm
+  : public RobustOptimizationAlgorithm
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  AdaptiveIntegrationRobustAlgorithm();
+
+  /** Parameter constructor */
+  AdaptiveIntegrationRobustAlgorithm(const RobustOptimizationProblem & problem,
+                                     const OT::OptimizationAlgorithm & solver);
+
+  /** Virtual constructor method */
+  AdaptiveIntegrationRobustAlgorithm * clone() const override;
+
+  /** Evaluation */
+  void run() override;
+
+  /** Integration accuracy of the first step accessor */
+  void setInitialMaximumError(const OT::Scalar initialMaximumError);
+  OT::Scalar getInitialMaximumError() const;
+
+  /** Integration accuracy of the last steps accessor */
+  void setFinalMaximumError(const OT::Scalar finalMaximumError);
+  OT::Scalar getFinalMaximumError() const;
+
+  /** Reduction of the integration accuracy between two steps accessor */
+  void setErrorReductionFactor(const OT::Scalar errorReductionFactor);
+  OT::Scalar getErrorReductionFactor() const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+  /** Method save() stores the object through the StorageManager */
+  void save(OT::Advocate & adv) const override;
+
+  /** Method load() reloads the object from the StorageManager */
+  void load(OT::Advocate & adv) override;
+
+private:
+  OT::Scalar initialMaximumError_ = 0.0;
+  OT::Scalar finalMaximumError_ = 0.0;
+  OT::Scalar errorReductionFactor_ = 0.0;
+
+}; /* class AdaptiveIntegrationRobustAlgorithm */
+
+} /* namespace OTROBOPT */
+
+#endif /* OTROBOPT_ADAPTIVEINTEGRATIONROBUSTALGORITHM_HXX */
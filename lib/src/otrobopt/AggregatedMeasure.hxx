@@ -52,11 +52,21 @@ public:
 
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
+  OT::Sample operator()(const OT::Sample & inS) const override;
 
   /** Distribution accessor */
   void setDistribution(const OT::Distribution & distribution) override;
   OT::Distribution getDistribution() const override;
 
+  /** Requested accuracy of the integration, applied to all the members */
+  void setMaximumError(const OT::Scalar maximumError) override;
+
+  /** Error estimates of the members, empty if one of them is unknown */
+  OT::Point getLastError() const override;
+
+  /** Next step of the smoothing bandwidth schedules of the members, false if none has one left */
+  OT::Bool reduceSmoothingBandwidth() override;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -67,8 +77,15 @@ public:
   void load(OT::Advocate & adv) override;
 
 private:
+  /** Group the members that can reduce the same values of the function */
+  void updateFusedGroups();
+
   MeasureEvaluationPersistentCollection collection_;
 
+  // For each member, the first member of its group, and whether the group has several members
+  OT::Indices leaders_;
+  OT::Indices fused_;
+
 }; /* class AggregatedMeasure */
 
 } /* namespace OTROBOPT */
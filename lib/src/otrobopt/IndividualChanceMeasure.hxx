@@ -51,11 +51,34 @@ public:
 
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
+  OT::Sample operator()(const OT::Sample & inS) const override;
+
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
 
   /** Alpha coefficient accessor */
   void setAlpha(const OT::Point & alpha);
   OT::Point getAlpha() const;
 
+  /** Smoothing bandwidth accessor */
+  void setSmoothingBandwidth(const OT::Scalar smoothingBandwidth);
+  OT::Scalar getSmoothingBandwidth() const;
+
+  /** Smoothing bandwidth at the end of the schedule accessor, 0 for no schedule */
+  void setFinalSmoothingBandwidth(const OT::Scalar finalSmoothingBandwidth);
+  OT::Scalar getFinalSmoothingBandwidth() const;
+
+  /** Reduction of the smoothing bandwidth between two steps of the schedule accessor */
+  void setSmoothingBandwidthReductionFactor(const OT::Scalar smoothingBandwidthReductionFactor);
+  OT::Scalar getSmoothingBandwidthReductionFactor() const;
+
+  /** Next step of the smoothing bandwidth schedule */
+  OT::Bool reduceSmoothingBandwidth() override;
+
+  /** Importance sampling size accessor, zero to integrate over the distribution */
+  void setImportanceSamplingSize(const OT::UnsignedInteger importanceSamplingSize);
+  OT::UnsignedInteger getImportanceSamplingSize() const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -65,9 +88,18 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
 private:
   OT::ComparisonOperator operator_;
   OT::Point alpha_;
+  OT::Scalar smoothingBandwidth_ = 0.0;
+  OT::Scalar finalSmoothingBandwidth_ = 0.0;
+  OT::Scalar smoothingBandwidthReductionFactor_ = 0.0;
+  OT::UnsignedInteger importanceSamplingSize_ = 0;
 
 }; /* class IndividualChanceMeasure */
 
@@ -50,6 +50,16 @@ public:
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
 
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
+
+  /** Hessian */
+  OT::SymmetricTensor hessian(const OT::Point & inP) const override;
+
+  /** Taylor control variate accessor */
+  void setControlVariate(const OT::Bool controlVariate);
+  OT::Bool getControlVariate() const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -59,7 +69,21 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
+  /** Same reduction, corrected by the first-order Taylor expansion at x if requested */
+  OT::Point computeDiscreteMeasure(const OT::Point & inP,
+                                   const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
 private:
+  /** Sum of the weights of the significant support, by which the discrete mean is not normalized */
+  OT::Scalar getSignificantWeightSum() const;
+
+  OT::Bool controlVariate_ = false;
 
 }; /* class MeanMeasure */
 
@@ -51,6 +51,9 @@ public:
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
 
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
+
   /** Alpha coefficient accessor */
   void setAlpha(const OT::Point & alpha);
   OT::Point getAlpha() const;
@@ -64,6 +67,11 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
 private:
   OT::Point alpha_;
 
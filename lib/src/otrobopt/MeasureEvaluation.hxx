@@ -26,6 +26,7 @@
 #include <openturns/Distribution.hxx>
 
 #include "otrobopt/OTRobOptprivate.hxx"
+#include "otrobopt/MeasureEvaluationCache.hxx"
 
 namespace OTROBOPT
 {
@@ -60,6 +61,30 @@ public:
 
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const;
+  OT::Sample operator()(const OT::Sample & inS) const;
+
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const;
+
+  /** Hessian */
+  OT::SymmetricTensor hessian(const OT::Point & inP) const;
+
+  /** Requested accuracy of the integration over a continuous distribution */
+  void setMaximumError(const OT::Scalar maximumError);
+  OT::Scalar getMaximumError() const;
+
+  /** Error estimate of the last evaluation over a continuous distribution */
+  OT::Point getLastError() const;
+
+  /** Next step of the smoothing bandwidth schedule, false if there is none left */
+  OT::Bool reduceSmoothingBandwidth();
+
+  /** Variance reduction of the control variate at the last evaluation */
+  OT::Point getLastVarianceReduction() const;
+
+  /** Cache of the function values shared with other measures */
+  void setEvaluationCache(const MeasureEvaluationCache & cache);
+  MeasureEvaluationCache getEvaluationCache() const;
 
   /** String converter */
   OT::String __repr__() const override;
@@ -0,0 +1,106 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Cache of the function values shared by measures
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef OTROBOPT_MEASUREEVALUATIONCACHE_HXX
+#define OTROBOPT_MEASUREEVALUATIONCACHE_HXX
+
+#include <openturns/Sample.hxx>
+#include <openturns/Indices.hxx>
+#include <openturns/Matrix.hxx>
+
+#include "otrobopt/OTRobOptprivate.hxx"
+
+#include <mutex>
+
+namespace OTROBOPT
+{
+
+/* forward declaration */
+class MeasureEvaluation;
+
+/**
+ * @class MeasureEvaluationCache
+ *
+ * Values and gradients of a parametric function at recent design points and
+ * at the nodes of a discrete distribution, keyed by (x, node index). Copies
+ * share the same storage, so that all the measures of a function on a
+ * discretized distribution evaluate it once per node and per design point.
+ */
+class OTROBOPT_API MeasureEvaluationCache
+{
+public:
+  /** Default constructor, the cache is disabled */
+  MeasureEvaluationCache();
+
+  /** Parameter constructor */
+  MeasureEvaluationCache(const OT::UnsignedInteger supportSize,
+                         const OT::UnsignedInteger maximumSize);
+
+  /** Whether the cache is enabled */
+  OT::Bool isEnabled() const;
+
+  /** Copy the known values at x on the given nodes into the rows of values,
+      and return the positions of the missing nodes */
+  OT::Indices find(const OT::Point & x,
+                   const OT::Indices & nodes,
+                   OT::Sample & values) const;
+
+  /** Store the values at x on the given nodes, the oldest point is replaced when full */
+  void add(const OT::Point & x,
+           const OT::Indices & nodes,
+           const OT::Sample & values);
+
+  /** Copy the gradient at x on the given node if it is known */
+  OT::Bool findGradient(const OT::Point & x,
+                        const OT::UnsignedInteger node,
+                        OT::Matrix & gradient) const;
+
+  /** Store the gradient at x on the given node */
+  void addGradient(const OT::Point & x,
+                   const OT::UnsignedInteger node,
+                   const OT::Matrix & gradient);
+
+  /** Attach a common cache to the measures of the same function reduced over the same nodes,
+      the support of a discrete distribution or the nodes of a fixed integration rule */
+  static void Share(OT::Collection<MeasureEvaluation> & measures);
+
+private:
+  struct Storage
+  {
+    std::mutex mutex_;
+    OT::UnsignedInteger supportSize_ = 0;
+    OT::UnsignedInteger maximumSize_ = 0;
+    OT::Collection<OT::Point> points_;
+    OT::Collection<OT::Sample> values_;
+    OT::Collection<OT::Indices> known_;
+    OT::Collection<OT::Collection<OT::Matrix> > gradients_;
+    OT::Collection<OT::Indices> knownGradients_;
+    OT::UnsignedInteger next_ = 0;
+  };
+
+  /** Slot of x in the storage, created when missing; the mutex must be held */
+  OT::UnsignedInteger locate(const OT::Point & x);
+
+  OT::Pointer<Storage> p_storage_;
+}; /* class MeasureEvaluationCache */
+
+} /* namespace OTROBOPT */
+
+#endif /* OTROBOPT_MEASUREEVALUATIONCACHE_HXX */
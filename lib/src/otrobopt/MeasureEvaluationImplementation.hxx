@@ -26,6 +26,10 @@
 
 #include <openturns/Distribution.hxx>
 #include <openturns/IntegrationAlgorithm.hxx>
+#include <openturns/GaussKronrod.hxx>
+#include <openturns/SymmetricTensor.hxx>
+#include <mutex>
+#include "otrobopt/MeasureEvaluationCache.hxx"
 
 namespace OTROBOPT
 {
@@ -53,6 +57,13 @@ public:
 
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
+  OT::Sample operator()(const OT::Sample & inS) const override;
+
+  /** Gradient with respect to x, by finite differences unless overloaded */
+  virtual OT::Matrix gradient(const OT::Point & inP) const;
+
+  /** Hessian with respect to x, by finite differences unless overloaded */
+  virtual OT::SymmetricTensor hessian(const OT::Point & inP) const;
 
   /** Distribution accessor */
   virtual void setDistribution(const OT::Distribution & distribution);
@@ -73,7 +84,35 @@ public:
   /** PDF threshold accessor */
   OT::Scalar getPDFThreshold() const;
 
-  void setPDFThreshold(const OT::Scalar threshold);
+  virtual void setPDFThreshold(const OT::Scalar threshold);
+
+  /** Requested accuracy of the integration over a continuous distribution */
+  virtual void setMaximumError(const OT::Scalar maximumError);
+  OT::Scalar getMaximumError() const;
+
+  /** Error estimate of the last evaluation over a continuous distribution, empty if unknown */
+  virtual OT::Point getLastError() const;
+
+  /** Next step of the smoothing bandwidth schedule, false if there is none left */
+  virtual OT::Bool reduceSmoothingBandwidth();
+
+  /** Ratio of the residual variance to the variance of the values at the last evaluation
+      corrected by a control variate, empty if none was used */
+  OT::Point getLastVarianceReduction() const;
+
+  /** Cache of the function values shared with other measures */
+  void setEvaluationCache(const MeasureEvaluationCache & cache);
+  MeasureEvaluationCache getEvaluationCache() const;
+
+  /** Number of nodes indexing the values shared with other measures: the size of the support of a
+      discrete distribution or of a fixed rule, 0 if the measure is integrated adaptively */
+  OT::UnsignedInteger getNodesNumber() const;
+
+  /** Whether the values of the function are reduced over the same nodes as another measure */
+  OT::Bool hasSameNodes(const MeasureEvaluationImplementation & other) const;
+
+  /** Half-width of the support of the gaussian smoothing kernels, in bandwidth units */
+  static const OT::Scalar KernelSupport;
 
   /** String converter */
   OT::String __repr__() const override;
@@ -86,6 +125,154 @@ public:
   void load(OT::Advocate & adv) override;
 
 protected:
+  /** Reduction of the function values over the retained discrete support */
+  virtual OT::Point computeDiscreteMeasure(const OT::Sample & values,
+      const OT::Point & weights) const;
+
+  /** Same reduction of the values at x, which allows a correction depending on x */
+  virtual OT::Point computeDiscreteMeasure(const OT::Point & inP,
+      const OT::Sample & values,
+      const OT::Point & weights) const;
+
+  /** Value of the measure at x from the values of the function on the significant support,
+      overloaded by the measures which keep track of their evaluations */
+  virtual OT::Point reduce(const OT::Point & inP,
+                           const OT::Sample & values) const;
+
+  /** Whether the values of the function are reduced over a fixed support:
+      the support of a discrete distribution or the nodes of a fixed integration rule */
+  OT::Bool hasSignificantSupport() const;
+
+  /** Number of nodes of the tensorized Gauss-Legendre rule replacing an adaptive rule
+      over a continuous distribution in the significant support, 0 for none */
+  void setSweepNodesNumber(const OT::UnsignedInteger sweepNodesNumber);
+
+  /** Nodes of a fixed integration rule over an interval and their weights, false for an adaptive rule */
+  static OT::Bool ComputeRuleNodes(const OT::IntegrationAlgorithm & algorithm,
+                                   const OT::Interval & interval,
+                                   OT::Sample & nodes,
+                                   OT::Point & weights);
+
+  /** PDF of a distribution at the nodes, by the product of the marginal PDFs for an independent copula */
+  static OT::Point ComputeNodesPDF(const OT::Distribution & distribution,
+                                   const OT::Sample & nodes);
+
+  /** Nodes and weights of a discrete distribution or a fixed integration rule above the PDF threshold */
+  const OT::Sample & getSignificantSupport() const;
+  const OT::Point & getSignificantWeights() const;
+
+  /** Evaluate the function at x on the significant support, through the shared cache if any */
+  OT::Sample evaluateSignificantSupport(const OT::Point & inP) const;
+
+  /** Evaluate the function on the grid of design points times significant support, through the shared cache if any */
+  OT::Sample evaluateSignificantSupport(const OT::Sample & inS) const;
+
+  /** Same evaluations and reduction by another measure, for the aggregation of measures sharing their values */
+  static OT::Sample EvaluateSignificantSupport(const MeasureEvaluationImplementation & measure,
+      const OT::Point & inP);
+  static OT::Sample EvaluateSignificantSupport(const MeasureEvaluationImplementation & measure,
+      const OT::Sample & inS);
+  static OT::Point Reduce(const MeasureEvaluationImplementation & measure,
+                          const OT::Point & inP,
+                          const OT::Sample & values);
+  static OT::UnsignedInteger GetSignificantSupportSize(const MeasureEvaluationImplementation & measure);
+
+  /** Gradient of the function at x on the k-th node of the significant support, through the shared cache if any */
+  OT::Matrix computeSignificantGradient(OT::Function & function,
+                                        const OT::Point & inP,
+                                        const OT::UnsignedInteger k) const;
+
+  /** Integral of a kernel over the range of the distribution and its error estimate */
+  OT::Point computeIntegral(const OT::Function & kernel,
+                            OT::Point & error) const;
+
+  /** Default integration algorithm set by the constructors, an iterated quadrature
+      of the given rule whose accuracy follows the requested one */
+  void setIteratedQuadrature(const OT::GaussKronrod & rule);
+
+  /** Store the error estimate of the current evaluation */
+  void setLastError(const OT::Point & error) const;
+
+  /** First-order Taylor expansion of the function with respect to the parameters around the mean
+      of the reference distribution, evaluated on the significant support, and its exact mean and
+      variance under the reference distribution */
+  void computeTaylorExpansion(const OT::Point & inP,
+                              OT::Sample & expansion,
+                              OT::Point & expansionMean,
+                              OT::Point & expansionVariance) const;
+
+  /** Weighted regression coefficients of each marginal of the values on the same marginal of a control
+      variate, the weighted variance of the control variate and the ratio of the residual variance */
+  static void ComputeControlVariate(const OT::Sample & values,
+                                    const OT::Sample & control,
+                                    const OT::Point & weights,
+                                    OT::Point & coefficient,
+                                    OT::Point & controlVariance,
+                                    OT::Point & reduction);
+
+  /** Store the variance reduction of the current evaluation */
+  void setLastVarianceReduction(const OT::Point & reduction) const;
+
+  /** Evaluate the function at x for each parameter value of the sample */
+  OT::Sample evaluateParametric(const OT::Point & inP,
+                                const OT::Sample & parameters) const;
+
+  /** Probability that the given marginals of the function are all nonnegative, or not all nonnegative
+      for the complementary event, by importance sampling. The gaussian proposal of the given slot is
+      adapted by cross-entropy and kept for the next evaluations, the variance of the estimate is returned */
+  OT::Scalar computeImportanceSampling(const OT::Point & inP,
+                                       const OT::Indices & marginals,
+                                       const OT::Bool complement,
+                                       const OT::Scalar bandwidth,
+                                       const OT::UnsignedInteger slot,
+                                       const OT::UnsignedInteger size,
+                                       OT::Scalar & variance) const;
+
+  /** Evaluate the function on the grid of design points times parameter values */
+  OT::Sample evaluateParametric(const OT::Sample & inS,
+                                const OT::Sample & parameters) const;
+
+  /** Mean and variance of f(x, Theta) and their derivatives with respect to x
+      up to the given order (1 or 2), in a single pass over the same integration
+      nodes or discrete support */
+  void computeDerivativeMoments(const OT::Point & inP,
+                                const OT::UnsignedInteger order,
+                                OT::Point & mean,
+                                OT::Point & variance,
+                                OT::Matrix & meanGradient,
+                                OT::Matrix & varianceGradient,
+                                OT::SymmetricTensor & meanHessian,
+                                OT::SymmetricTensor & varianceHessian) const;
+
+  /** Weighted mean and variance of each marginal of a sample in a single pass */
+  static void ComputeWeightedMoments(const OT::Sample & values,
+                                     const OT::Point & weights,
+                                     OT::Point & mean,
+                                     OT::Point & variance);
+
+  /** Weighted quantile of the first marginal of a sample by partial selection */
+  static OT::Scalar ComputeWeightedQuantile(const OT::Sample & values,
+      const OT::Point & weights,
+      const OT::Scalar alpha);
+
+  /** Weighted probability that each marginal of a sample is nonnegative */
+  static OT::Point ComputeWeightedExceedance(const OT::Sample & values,
+      const OT::Point & weights);
+
+  /** Weighted probability that all the marginals of a sample are nonnegative */
+  static OT::Scalar ComputeWeightedJointExceedance(const OT::Sample & values,
+      const OT::Point & weights);
+
+  /** Same as ComputeWeightedExceedance with the indicator smoothed by the normal CDF */
+  static OT::Point ComputeWeightedSmoothedExceedance(const OT::Sample & values,
+      const OT::Point & weights,
+      const OT::Scalar bandwidth);
+
+  /** Same as ComputeWeightedJointExceedance with the indicators smoothed by the normal CDF */
+  static OT::Scalar ComputeWeightedSmoothedJointExceedance(const OT::Sample & values,
+      const OT::Point & weights,
+      const OT::Scalar bandwidth);
+
   /** Underlying parametric function */
   OT::Function function_;
 
@@ -97,6 +284,91 @@ protected:
 
   /** Threshold under which PDF is consider to be zero */
   OT::Scalar pdfThreshold_;
+
+  /** Requested accuracy of the integration algorithm */
+  OT::Scalar maximumError_;
+
+  /** Continuous distribution approximated by the discrete distribution or the nodes,
+      whose moments are known by the control variates */
+  OT::Distribution referenceDistribution_;
+
+private:
+  /** Error estimate or variance reduction written by the concurrent evaluations */
+  class PointRecord
+  {
+  public:
+    PointRecord();
+    PointRecord(const PointRecord & other);
+    PointRecord & operator =(const PointRecord & other);
+
+    void set(const OT::Point & value);
+    OT::Point get() const;
+
+  private:
+    mutable std::mutex mutex_;
+    OT::Point value_;
+  };
+
+  /** Importance sampling proposals adapted by the concurrent evaluations */
+  class ProposalCache
+  {
+  public:
+    ProposalCache();
+    ProposalCache(const ProposalCache & other);
+    ProposalCache & operator =(const ProposalCache & other);
+
+    /** Standard normal sample shared by the proposals, drawn once for a given size */
+    OT::Sample getStandardSample(const OT::UnsignedInteger size,
+                                 const OT::UnsignedInteger dimension);
+
+    OT::Bool find(const OT::UnsignedInteger slot,
+                  OT::Point & mean,
+                  OT::Point & sigma) const;
+    void set(const OT::UnsignedInteger slot,
+             const OT::Point & mean,
+             const OT::Point & sigma);
+    void clear();
+
+  private:
+    mutable std::mutex mutex_;
+    OT::Sample standardSample_;
+    OT::Collection<OT::Point> means_;
+    OT::Collection<OT::Point> sigmas_;
+  };
+
+  /** Prune the support of a discrete distribution or the nodes of a fixed rule once for all the evaluations */
+  void updateSignificantSupport();
+
+  /** Draw the quasi-Monte Carlo nodes, if any, from the distribution of the measure */
+  void updateIntegrationAlgorithm();
+
+  /** Standard deviation of the measure over the replications of the quasi-Monte Carlo nodes */
+  OT::Point computeReplicationsError(const OT::Sample & values) const;
+
+  /** Nodes of a discrete distribution or a fixed rule above the PDF threshold and their weights */
+  OT::Sample significantSupport_;
+  OT::Point significantWeights_;
+  OT::Indices significantIndices_;
+  OT::Bool hasIntegrationNodes_ = false;
+  OT::UnsignedInteger sweepNodesNumber_ = 0;
+  OT::UnsignedInteger nodesNumber_ = 0;
+
+  /** Randomly shifted replications of the quasi-Monte Carlo nodes, as consecutive blocks of nodes */
+  OT::UnsignedInteger replicationsNumber_ = 0;
+  OT::UnsignedInteger replicationSize_ = 0;
+
+  /** Inner rule of the default iterated quadrature, if it has not been replaced */
+  OT::GaussKronrod iteratedRule_;
+  OT::Bool hasIteratedRule_ = false;
+
+  /** Function values shared by the measures of the same function and discrete distribution */
+  mutable MeasureEvaluationCache evaluationCache_;
+
+  mutable PointRecord lastError_;
+
+  mutable PointRecord lastVarianceReduction_;
+
+  mutable ProposalCache proposals_;
 }; /* class MeasureEvaluationImplementation */
 
 } /* namespace OTROBOPT */
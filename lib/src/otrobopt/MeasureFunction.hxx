@@ -24,6 +24,8 @@
 #include <openturns/FunctionImplementation.hxx>
 
 #include "otrobopt/MeasureEvaluation.hxx"
+#include "otrobopt/MeasureGradient.hxx"
+#include "otrobopt/MeasureHessian.hxx"
 
 namespace OTROBOPT
 {
@@ -0,0 +1,71 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Measure function hessian
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef OTROBOPT_MEASUREHESSIAN_HXX
+#define OTROBOPT_MEASUREHESSIAN_HXX
+
+#include <openturns/HessianImplementation.hxx>
+
+#include "otrobopt/MeasureEvaluation.hxx"
+
+namespace OTROBOPT
+{
+
+/**
+ * @class MeasureHessian
+ *
+ * Measure function hessian
+ */
+class OTROBOPT_API MeasureHessian
+  : public OT::HessianImplementation
+{
+  CLASSNAME
+
+public:
+
+  /** Default constructor */
+  MeasureHessian();
+
+  explicit MeasureHessian(const MeasureEvaluation & evaluation);
+
+  MeasureHessian * clone() const override;
+
+  /** Hessian */
+  OT::SymmetricTensor hessian(const OT::Point & inP) const override;
+
+  OT::UnsignedInteger getInputDimension() const override;
+  OT::UnsignedInteger getOutputDimension() const override;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+  /** Method save() stores the object through the StorageManager */
+  void save(OT::Advocate & adv) const override;
+
+  /** Method load() reloads the object from the StorageManager */
+  void load(OT::Advocate & adv) override;
+
+private:
+  MeasureEvaluation evaluation_;
+}; /* class MeasureHessian */
+
+} /* namespace OTROBOPT */
+
+#endif /* OTROBOPT_MEASUREHESSIAN_HXX */
@@ -21,6 +21,8 @@
 #ifndef OTROBOPT_QUANTILEMEASURE_HXX
 #define OTROBOPT_QUANTILEMEASURE_HXX
 
+#include <mutex>
+
 #include "otrobopt/MeasureEvaluationImplementation.hxx"
 
 namespace OTROBOPT
@@ -51,10 +53,31 @@ public:
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
 
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
+
+  /** Distribution accessor */
+  void setDistribution(const OT::Distribution & distribution) override;
+
+  /** Function accessor */
+  void setFunction(const OT::Function & function) override;
+
+  /** Integration algorithm accessor */
+  void setIntegrationAlgorithm(const OT::IntegrationAlgorithm & algorithm) override;
+
+  /** PDF threshold accessor */
+  void setPDFThreshold(const OT::Scalar threshold) override;
+
   /** Alpha coefficient accessor */
   void setAlpha(const OT::Scalar alpha);
   OT::Scalar getAlpha() const;
 
+  /** Single sweep accessor: with an adaptive integration algorithm, the continuous
+      quantile is the weighted quantile of the function values at the nodes of a
+      tensorized Gauss-Legendre rule, computed once */
+  void setSingleSweep(const OT::Bool singleSweep);
+  OT::Bool getSingleSweep() const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -64,8 +87,49 @@ public:
   /** Method load() reloads the object from the StorageManager */
   virtual void load(OT::Advocate & adv) override;
 
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
 private:
+  /** Bandwidth of the gradient kernel from the standard deviation of the values and the effective number of nodes */
+  static OT::Scalar ComputeBandwidth(const OT::Scalar sigma,
+                                     const OT::Scalar effectiveSize);
+
+  /** Last quantile computed and the step to bracket the next one */
+  class BracketCache
+  {
+  public:
+    BracketCache();
+    BracketCache(const BracketCache & other);
+    BracketCache & operator =(const BracketCache & other);
+
+    /** Last design point, quantile and step, if any */
+    OT::Bool find(OT::Point & x,
+                  OT::Scalar & quantile,
+                  OT::Scalar & step) const;
+
+    /** Store the quantile found at x */
+    void set(const OT::Point & x,
+             const OT::Scalar quantile,
+             const OT::Scalar step);
+
+    void clear();
+
+  private:
+    mutable std::mutex mutex_;
+    OT::Point x_;
+    OT::Scalar quantile_ = 0.0;
+    OT::Scalar step_ = 1.0;
+    OT::Bool hasValue_ = false;
+  };
+
   OT::Scalar alpha_ = 0.0;
+  OT::Bool singleSweep_ = false;
+
+  // The outer optimizers evaluate the measure at neighbouring points
+  mutable BracketCache lastBracket_;
 
 }; /* class QuantileMeasure */
 
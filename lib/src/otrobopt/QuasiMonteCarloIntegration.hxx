@@ -0,0 +1,119 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Randomized quasi-Monte Carlo integration
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef OTROBOPT_QUASIMONTECARLOINTEGRATION_HXX
+#define OTROBOPT_QUASIMONTECARLOINTEGRATION_HXX
+
+#include <openturns/IntegrationAlgorithmImplementation.hxx>
+#include <openturns/LowDiscrepancySequence.hxx>
+#include <openturns/SobolSequence.hxx>
+#include <openturns/Distribution.hxx>
+
+#include "otrobopt/OTRobOptprivate.hxx"
+
+namespace OTROBOPT
+{
+
+/**
+ * @class QuasiMonteCarloIntegration
+ *
+ * Integration with low discrepancy nodes mapped through the inverse
+ * iso-probabilistic transformation of a distribution, and randomly shifted
+ * replications to estimate the error. The cost is linear in the number of
+ * nodes whatever the dimension.
+ */
+class OTROBOPT_API QuasiMonteCarloIntegration
+  : public OT::IntegrationAlgorithmImplementation
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  QuasiMonteCarloIntegration();
+
+  /** Parameter constructor */
+  explicit QuasiMonteCarloIntegration(const OT::UnsignedInteger size,
+                                      const OT::LowDiscrepancySequence & sequence = OT::SobolSequence());
+
+  /** Virtual constructor method */
+  QuasiMonteCarloIntegration * clone() const override;
+
+  /** Compute an approximation of the integral of the function over the interval */
+  using OT::IntegrationAlgorithmImplementation::integrate;
+  OT::Point integrate(const OT::Function & function,
+                      const OT::Interval & interval) const override;
+
+  /** Same, with the standard deviation of the estimate over the replications */
+  OT::Point integrate(const OT::Function & function,
+                      const OT::Interval & interval,
+                      OT::Point & error) const;
+
+  /** Nodes of all the replications and their weights in the estimate of the integral */
+  OT::Sample generateWithWeights(const OT::Interval & interval,
+                                 OT::Point & weights) const;
+
+  /** Total number of nodes accessor */
+  void setSize(const OT::UnsignedInteger size);
+  OT::UnsignedInteger getSize() const;
+
+  /** Number of randomly shifted replications accessor */
+  void setReplicationsNumber(const OT::UnsignedInteger replicationsNumber);
+  OT::UnsignedInteger getReplicationsNumber() const;
+
+  /** Low discrepancy sequence accessor */
+  void setSequence(const OT::LowDiscrepancySequence & sequence);
+  OT::LowDiscrepancySequence getSequence() const;
+
+  /** Distribution of the nodes accessor, uniform over the interval if not set */
+  void setDistribution(const OT::Distribution & distribution);
+  OT::Distribution getDistribution() const;
+  OT::Bool hasDistribution() const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+  /** Method save() stores the object through the StorageManager */
+  void save(OT::Advocate & adv) const override;
+
+  /** Method load() reloads the object from the StorageManager */
+  void load(OT::Advocate & adv) override;
+
+private:
+  /** Map points of the unit cube to the distribution */
+  static OT::Sample ComputeNodes(const OT::Distribution & distribution,
+                                 const OT::Sample & uniform);
+
+  /** Draw the shifts of the replications */
+  static OT::Sample DrawShifts(const OT::UnsignedInteger replicationsNumber,
+                               const OT::UnsignedInteger dimension);
+
+  OT::UnsignedInteger size_ = 0;
+  OT::UnsignedInteger replicationsNumber_ = 0;
+  OT::LowDiscrepancySequence sequence_;
+  OT::Distribution distribution_;
+  OT::Bool hasDistribution_ = false;
+
+  // Cranley-Patterson shifts, drawn once so that the estimate is a smooth function of x
+  OT::Sample shifts_;
+}; /* class QuasiMonteCarloIntegration */
+
+} /* namespace OTROBOPT */
+
+#endif /* OTROBOPT_QUASIMONTECARLOINTEGRATION_HXX */
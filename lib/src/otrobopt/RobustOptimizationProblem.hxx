@@ -76,6 +76,9 @@ public:
   virtual void load(OT::Advocate & adv) override;
 
 private:
+  /** Feed the objective and the constraint from the same evaluations of the function */
+  void shareEvaluations();
+
   MeasureEvaluation robustnessMeasure_;
   MeasureEvaluation reliabilityMeasure_;
 
@@ -0,0 +1,93 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief Dimension-adaptive Smolyak sparse grid integration
+ *
+ *  Copyright 2005-2024 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef OTROBOPT_SPARSEGRIDINTEGRATION_HXX
+#define OTROBOPT_SPARSEGRIDINTEGRATION_HXX
+
+#include <openturns/IntegrationAlgorithmImplementation.hxx>
+
+#include "otrobopt/OTRobOptprivate.hxx"
+
+namespace OTROBOPT
+{
+
+/**
+ * @class SparseGridIntegration
+ *
+ * Smolyak quadrature built from the nested Clenshaw-Curtis rules, whose
+ * index set is refined in the directions with the largest contributions
+ * (Gerstner and Griebel). The nodes of a level are reused by the finer
+ * ones, so each one is evaluated once whatever the number of refinements.
+ */
+class OTROBOPT_API SparseGridIntegration
+  : public OT::IntegrationAlgorithmImplementation
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  SparseGridIntegration();
+
+  /** Parameter constructor */
+  explicit SparseGridIntegration(const OT::Scalar maximumError);
+
+  /** Virtual constructor method */
+  SparseGridIntegration * clone() const override;
+
+  /** Compute an approximation of the integral of the function over the interval */
+  using OT::IntegrationAlgorithmImplementation::integrate;
+  OT::Point integrate(const OT::Function & function,
+                      const OT::Interval & interval) const override;
+
+  /** Same, with the sum of the contributions of the indices not refined yet */
+  OT::Point integrate(const OT::Function & function,
+                      const OT::Interval & interval,
+                      OT::Point & error) const;
+
+  /** Maximum error accessor */
+  void setMaximumError(const OT::Scalar maximumError);
+  OT::Scalar getMaximumError() const;
+
+  /** Maximum number of evaluations of the integrand accessor */
+  void setMaximumCallsNumber(const OT::UnsignedInteger maximumCallsNumber);
+  OT::UnsignedInteger getMaximumCallsNumber() const;
+
+  /** Maximum level of the one-dimensional rules accessor */
+  void setMaximumLevel(const OT::UnsignedInteger maximumLevel);
+  OT::UnsignedInteger getMaximumLevel() const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+  /** Method save() stores the object through the StorageManager */
+  void save(OT::Advocate & adv) const override;
+
+  /** Method load() reloads the object from the StorageManager */
+  void load(OT::Advocate & adv) override;
+
+private:
+  OT::Scalar maximumError_ = 0.0;
+  OT::UnsignedInteger maximumCallsNumber_ = 0;
+  OT::UnsignedInteger maximumLevel_ = 0;
+}; /* class SparseGridIntegration */
+
+} /* namespace OTROBOPT */
+
+#endif /* OTROBOPT_SPARSEGRIDINTEGRATION_HXX */
@@ -50,6 +50,16 @@ public:
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
 
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
+
+  /** Hessian */
+  OT::SymmetricTensor hessian(const OT::Point & inP) const override;
+
+  /** Taylor control variate accessor */
+  void setControlVariate(const OT::Bool controlVariate);
+  OT::Bool getControlVariate() const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -59,8 +69,18 @@ public:
   /** Method load() reloads the object from the StorageManager */
   virtual void load(OT::Advocate & adv) override;
 
-private:
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
+  /** Same reduction, corrected by the first-order Taylor expansion at x if requested */
+  OT::Point computeDiscreteMeasure(const OT::Point & inP,
+                                   const OT::Sample & values,
+                                   const OT::Point & weights) const override;
 
+private:
+  OT::Bool controlVariate_ = false;
 
 }; /* class VarianceMeasure */
 
@@ -24,6 +24,8 @@
 #include <openturns/OptimizationAlgorithm.hxx>
 #include "otrobopt/MeasureEvaluationImplementation.hxx"
 
+#include <mutex>
+
 namespace OTROBOPT
 {
 
@@ -51,6 +53,19 @@ public:
 
   /** Evaluation */
   OT::Point operator()(const OT::Point & inP) const override;
+  OT::Sample operator()(const OT::Sample & inS) const override;
+
+  /** Gradient */
+  OT::Matrix gradient(const OT::Point & inP) const override;
+
+  /** Distribution accessor */
+  void setDistribution(const OT::Distribution & distribution) override;
+
+  /** Function accessor */
+  void setFunction(const OT::Function & function) override;
+
+  /** PDF threshold accessor */
+  void setPDFThreshold(const OT::Scalar threshold) override;
 
   /** Optimization solver accessor */
   void setOptimizationAlgorithm(const OT::OptimizationAlgorithm & solver);
@@ -60,6 +75,14 @@ public:
   void setMinimization(const OT::Bool minimization);
   OT::Bool isMinimization() const;
 
+  /** Number of starting points of the inner optimizations accessor */
+  void setStartingPointsNumber(const OT::UnsignedInteger startingPointsNumber);
+  OT::UnsignedInteger getStartingPointsNumber() const;
+
+  /** Size of the cache of warm starts of the inner optimizations accessor */
+  void setWarmStartCacheSize(const OT::UnsignedInteger warmStartCacheSize);
+  OT::UnsignedInteger getWarmStartCacheSize() const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -69,9 +92,62 @@ public:
   /** Method load() reloads the object from the StorageManager */
   virtual void load(OT::Advocate & adv) override;
 
+protected:
+  /** Reduction of the function values over the retained discrete support */
+  OT::Point computeDiscreteMeasure(const OT::Sample & values,
+                                   const OT::Point & weights) const override;
+
+  /** Same reduction at x, keeping the extremal nodes for the gradient */
+  OT::Point reduce(const OT::Point & inP,
+                   const OT::Sample & values) const override;
+
 private:
+  /** Bounded cache of the optimal parameters found at recent design points */
+  class OptimaCache
+  {
+  public:
+    OptimaCache();
+    OptimaCache(const OptimaCache & other);
+    OptimaCache & operator =(const OptimaCache & other);
+
+    /** Optimal parameters of each marginal found at the nearest cached point */
+    OT::Bool find(const OT::Point & x,
+                  OT::Sample & optima) const;
+
+    /** Optimal parameters of each marginal found exactly at x */
+    OT::Bool lookup(const OT::Point & x,
+                    OT::Sample & optima) const;
+
+    /** Store the optimal parameters found at x, the oldest entry is replaced when full */
+    void add(const OT::Point & x,
+             const OT::Sample & optima,
+             const OT::UnsignedInteger maximumSize);
+
+    void clear();
+
+  private:
+    mutable std::mutex mutex_;
+    OT::Collection<OT::Point> points_;
+    OT::Collection<OT::Sample> optima_;
+    OT::UnsignedInteger next_ = 0;
+  };
+
+  /** Worst-case values and the parameters reaching them for each marginal */
+  OT::Point computeOptima(const OT::Point & inP,
+                          OT::Sample & optima) const;
+
+  /** Extremal values over the significant support and the nodes reaching them for each marginal */
+  OT::Point computeDiscreteOptima(const OT::Sample & values,
+                                  OT::Sample & optima) const;
+
   OT::Bool isMinimization_ = true;
   OT::OptimizationAlgorithm solver_;
+  OT::UnsignedInteger startingPointsNumber_ = 1;
+  OT::UnsignedInteger warmStartCacheSize_ = 0;
+  mutable OptimaCache warmStartCache_;
+
+  // Optimal parameters of the last evaluation, reused by the gradient
+  mutable OptimaCache lastOptima_;
 
 }; /* class WorstCaseMeasure */
 
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <iomanip>
+
+#include "otrobopt/OTRobOpt.hxx"
+#include "openturns/OT.hxx"
+
+
+using namespace OT;
+using namespace OTROBOPT;
+
+int main()
+{
+  Normal thetaDist(2.0, 0.1);
+  Description input(2);
+  input[0] = "x";
+  input[1] = "theta";
+
+  // The integration accuracy is tightened along the robust optimization
+  const ParametricFunction distance(SymbolicFunction(input, Description(1, "(x-theta)^2")), Indices(1, 1), Point(1, 2.0));
+  RobustOptimizationProblem problem;
+  problem.setRobustnessMeasure(MeanMeasure(distance, thetaDist));
+  Cobyla solver;
+  solver.setStartingPoint(Point(1, 0.0));
+  AdaptiveIntegrationRobustAlgorithm algo(problem, solver);
+  algo.setMaximumIterationNumber(10);
+  std::cout << algo << std::endl;
+  algo.run();
+  const Point optimum(algo.getResult().getOptimalPoint());
+  if (std::abs(optimum[0] - 2.0) > 1e-3)
+    throw InternalException(HERE) << "Adaptive integration optimum " << optimum << " differs from 2";
+  std::cout << "optimum=" << std::setprecision(3) << optimum[0] << std::endl;
+
+  // The smoothing bandwidth of a chance constraint shrinks along with the accuracy:
+  // P(theta - x >= 0) >= 0.9 bounds x by the 0.1 quantile of theta
+  const ParametricFunction margin(SymbolicFunction(input, Description(1, "theta-x")), Indices(1, 1), Point(1, 2.0));
+  JointChanceMeasure reliability(margin, thetaDist, GreaterOrEqual(), 0.9);
+  reliability.setSmoothingBandwidth(1e-2);
+  reliability.setFinalSmoothingBandwidth(1e-3);
+  RobustOptimizationProblem constrainedProblem(MeasureEvaluation(MeanMeasure(distance, thetaDist)), MeasureEvaluation(reliability));
+  AdaptiveIntegrationRobustAlgorithm constrainedAlgo(constrainedProblem, solver);
+  constrainedAlgo.setInitialMaximumError(1e-4);
+  constrainedAlgo.setFinalMaximumError(1e-8);
+  constrainedAlgo.setMaximumIterationNumber(10);
+  std::cout << constrainedAlgo << std::endl;
+  constrainedAlgo.run();
+  const Point constrainedOptimum(constrainedAlgo.getResult().getOptimalPoint());
+  const Scalar bound = thetaDist.computeQuantile(0.1)[0];
+  if (std::abs(constrainedOptimum[0] - bound) > 1e-2)
+    throw InternalException(HERE) << "Constrained adaptive integration optimum " << constrainedOptimum << " differs from " << bound;
+  std::cout << "constrained optimum=" << std::setprecision(2) << constrainedOptimum[0] << std::endl;
+  return 0;
+}
@@ -51,8 +51,196 @@ int main()
         MeasureFactory factory(experiment);
         MeasureEvaluation discretizedMeasure(factory.build(measure));
         std::cout << discretizedMeasure << "(discretized Gauss)" << discretizedMeasure(x) << std::endl;
+        // The batch evaluation must match the point evaluation
+        const Sample values(discretizedMeasure(Sample(3, x)));
+        if (Point(values[2]) != discretizedMeasure(x))
+          throw InternalException(HERE) << "Sample evaluation differs from point evaluation";
+        // The gradient must match finite differences, except for the
+        // kernel-smoothed gradient of the quantile which only approximates it
+        const Matrix gradient(discretizedMeasure.gradient(x));
+        const Matrix fdGradient(CenteredFiniteDifferenceGradient(ResourceMap::GetAsScalar("CenteredFiniteDifferenceGradient-DefaultEpsilon"), Evaluation(discretizedMeasure.getImplementation())).gradient(x));
+        const Scalar gradientTolerance = (discretizedMeasure.getImplementation()->getClassName() == "QuantileMeasure" ? 0.1 : 1e-5);
+        for (UnsignedInteger j = 0; j < gradient.getNbColumns(); ++ j)
+          if (std::abs(gradient(0, j) - fdGradient(0, j)) > gradientTolerance * (1.0 + std::abs(fdGradient(0, j))))
+            throw InternalException(HERE) << "Gradient " << gradient << " differs from finite differences " << fdGradient;
+        // Same for the hessian
+        const SymmetricTensor hessian(discretizedMeasure.hessian(x));
+        const SymmetricTensor fdHessian(CenteredFiniteDifferenceHessian(ResourceMap::GetAsScalar("CenteredFiniteDifferenceHessian-DefaultEpsilon"), Evaluation(discretizedMeasure.getImplementation())).hessian(x));
+        for (UnsignedInteger j = 0; j < hessian.getNbSheets(); ++ j)
+          if (std::abs(hessian(0, 0, j) - fdHessian(0, 0, j)) > 1e-4 * (1.0 + std::abs(fdHessian(0, 0, j))))
+            throw InternalException(HERE) << "Hessian " << hessian << " differs from finite differences " << fdHessian;
       }
     }
+    // The derivatives of the mean match its value when the PDF threshold prunes the support
+    {
+      Sample support(3, 1);
+      support(0, 0) = 1.8;
+      support(1, 0) = 2.0;
+      support(2, 0) = 2.2;
+      Point probabilities(3);
+      probabilities[0] = 0.3;
+      probabilities[1] = 0.69;
+      probabilities[2] = 0.01;
+      const ParametricFunction distance(SymbolicFunction(input, Description(1, "(x-theta)^2")), Indices(1, 1), Point(1, 2.0));
+      MeanMeasure prunedMean(distance, UserDefined(support, probabilities));
+      prunedMean.setPDFThreshold(0.05);
+      const Matrix gradient(prunedMean.gradient(x));
+      const Matrix fdGradient(CenteredFiniteDifferenceGradient(ResourceMap::GetAsScalar("CenteredFiniteDifferenceGradient-DefaultEpsilon"), Evaluation(prunedMean)).gradient(x));
+      if (std::abs(gradient(0, 0) - fdGradient(0, 0)) > 1e-5 * (1.0 + std::abs(fdGradient(0, 0))))
+        throw InternalException(HERE) << "Pruned mean gradient " << gradient << " differs from finite differences " << fdGradient;
+      const SymmetricTensor hessian(prunedMean.hessian(x));
+      const SymmetricTensor fdHessian(CenteredFiniteDifferenceHessian(ResourceMap::GetAsScalar("CenteredFiniteDifferenceHessian-DefaultEpsilon"), Evaluation(prunedMean)).hessian(x));
+      if (std::abs(hessian(0, 0, 0) - fdHessian(0, 0, 0)) > 1e-4 * (1.0 + std::abs(fdHessian(0, 0, 0))))
+        throw InternalException(HERE) << "Pruned mean hessian " << hessian << " differs from finite differences " << fdHessian;
+    }
+    // The measures discretized together share the evaluations of the function
+    {
+      Collection <MeasureEvaluation> moments;
+      moments.add(MeanMeasure(f, thetaDist));
+      moments.add(VarianceMeasure(f, thetaDist));
+      MeasureFactory factory(GaussProductExperiment(Indices(1, 4)));
+      const Collection <MeasureEvaluation> shared(factory.buildCollection(moments));
+      if (!shared[0].getEvaluationCache().isEnabled() || !shared[1].getEvaluationCache().isEnabled())
+        throw InternalException(HERE) << "The discretized measures do not share their evaluations";
+      for (UnsignedInteger i = 0; i < moments.getSize(); ++ i)
+        if (shared[i](x) != factory.build(moments[i])(x))
+          throw InternalException(HERE) << "Shared evaluation differs from the standalone one";
+      // Same for the objective and the constraint of a robust problem
+      RobustOptimizationProblem problem;
+      problem.setRobustnessMeasure(factory.build(moments[0]));
+      problem.setReliabilityMeasure(factory.build(JointChanceMeasure(f, thetaDist, GreaterOrEqual(), 0.5)));
+      if (!problem.getRobustnessMeasure().getEvaluationCache().isEnabled() || !problem.getReliabilityMeasure().getEvaluationCache().isEnabled())
+        throw InternalException(HERE) << "The objective and the constraint do not share their evaluations";
+      if (problem.getObjective()(x) != shared[0](x))
+        throw InternalException(HERE) << "Shared objective differs from the standalone one";
+      if (!(problem.getObjective().gradient(x) == shared[0].gradient(x)))
+        throw InternalException(HERE) << "Shared objective gradient differs from the standalone one";
+      // Also over a continuous distribution, with the nodes of the same fixed rule
+      MeanMeasure ruleObjective(f, thetaDist);
+      ruleObjective.setIntegrationAlgorithm(GaussLegendre(Indices(1, 8)));
+      JointChanceMeasure ruleConstraint(f, thetaDist, GreaterOrEqual(), 0.5);
+      ruleConstraint.setIntegrationAlgorithm(GaussLegendre(Indices(1, 8)));
+      const RobustOptimizationProblem ruleProblem(MeasureEvaluation(ruleObjective), MeasureEvaluation(ruleConstraint));
+      if (!ruleProblem.getRobustnessMeasure().getEvaluationCache().isEnabled() || !ruleProblem.getReliabilityMeasure().getEvaluationCache().isEnabled())
+        throw InternalException(HERE) << "The objective and the constraint on the same nodes do not share their evaluations";
+      if (ruleProblem.getObjective()(x) != ruleObjective(x))
+        throw InternalException(HERE) << "Shared objective on the rule nodes differs from the standalone one";
+    }
+    // The aggregation reduces the shared evaluations through each member
+    {
+      Collection <MeasureEvaluation> members;
+      members.add(MeanMeasure(f, thetaDist));
+      members.add(WorstCaseMeasure(f, thetaDist, false));
+      MeasureFactory factory(GaussProductExperiment(Indices(1, 4)));
+      const Collection <MeasureEvaluation> shared(factory.buildCollection(members));
+      const AggregatedMeasure aggregated(shared);
+      Sample designPoints(3, 1);
+      designPoints(0, 0) = 0.5;
+      designPoints(1, 0) = 1.0;
+      designPoints(2, 0) = 1.5;
+      const Sample values(aggregated(designPoints));
+      for (UnsignedInteger k = 0; k < designPoints.getSize(); ++ k)
+      {
+        if (Point(values[k]) != aggregated(designPoints[k]))
+          throw InternalException(HERE) << "Aggregated sample evaluation differs from point evaluation";
+        for (UnsignedInteger i = 0; i < shared.getSize(); ++ i)
+          if (values(k, i) != shared[i](designPoints[k])[0])
+            throw InternalException(HERE) << "Aggregated evaluation differs from the member one";
+      }
+    }
+    // The worst case over a continuous distribution is optimized at each design point
+    // of a sample, not searched among the nodes of the integration rule
+    {
+      WorstCaseMeasure worstCase(f, Uniform(-1.0, 4.0));
+      worstCase.setIntegrationAlgorithm(GaussLegendre(Indices(1, 8)));
+      const Sample values(worstCase(Sample(2, x)));
+      if (Point(values[1]) != worstCase(x))
+        throw InternalException(HERE) << "Worst case sample evaluation " << values << " differs from point evaluation " << worstCase(x);
+    }
+    // The single sweep quantile evaluates the function once per node
+    {
+      QuantileMeasure quantile(f, thetaDist, 0.99);
+      const Scalar reference = quantile(x)[0];
+      quantile.setSingleSweep(true);
+      if (std::abs(quantile(x)[0] - reference) > 1e-2)
+        throw InternalException(HERE) << "Single sweep quantile " << quantile(x) << " differs from " << reference;
+      // The quantile of x*theta is x times the quantile of theta
+      const Scalar derivative = thetaDist.computeQuantile(0.99)[0];
+      if (std::abs(quantile.gradient(x)(0, 0) - derivative) > 1e-1)
+        throw InternalException(HERE) << "Single sweep quantile gradient " << quantile.gradient(x) << " differs from " << derivative;
+      // A default measure sweeps the same nodes when the mode is enabled by the ResourceMap
+      ResourceMap::SetAsBool("QuantileMeasure-SingleSweep", true);
+      QuantileMeasure defaultQuantile;
+      ResourceMap::SetAsBool("QuantileMeasure-SingleSweep", false);
+      defaultQuantile.setFunction(f);
+      defaultQuantile.setAlpha(0.99);
+      defaultQuantile.setDistribution(thetaDist);
+      if (!defaultQuantile.getSingleSweep() || (defaultQuantile(x) != quantile(x)))
+        throw InternalException(HERE) << "Default single sweep quantile " << defaultQuantile(x) << " differs from " << quantile(x);
+    }
+    // The quantile at a neighbouring point starts from the last bracket
+    {
+      QuantileMeasure quantile(f, thetaDist, 0.99);
+      quantile(x);
+      const Point y(1, 1.01);
+      const Scalar reference = QuantileMeasure(f, thetaDist, 0.99)(y)[0];
+      if (std::abs(quantile(y)[0] - reference) > 1e-4)
+        throw InternalException(HERE) << "Warm started quantile " << quantile(y) << " differs from " << reference;
+    }
+    // The integration accuracy can be requested along with an error estimate
+    {
+      MeanMeasure mean(f, thetaDist);
+      mean.setIntegrationAlgorithm(GaussKronrod());
+      mean.setMaximumError(1e-8);
+      const Point value(mean(x));
+      const Point error(mean.getLastError());
+      if ((error.getDimension() != 1) || !(error[0] <= 1e-8) || (std::abs(value[0] - 2.0) > 1e-6))
+        throw InternalException(HERE) << "Mean " << value << " with error " << error << " differs from 2";
+      // The default iterated quadrature estimates its error through its inner rule in dimension 1
+      MeanMeasure defaultMean(f, thetaDist);
+      defaultMean.setMaximumError(1e-8);
+      defaultMean(x);
+      if ((defaultMean.getLastError().getDimension() != 1) || !(defaultMean.getLastError()[0] <= 1e-8))
+        throw InternalException(HERE) << "Iterated quadrature error " << defaultMean.getLastError() << " exceeds 1e-8";
+      // while an iterated quadrature set by the user is kept, with an unknown error
+      const IteratedQuadrature userAlgorithm;
+      MeanMeasure userMean(f, thetaDist);
+      userMean.setIntegrationAlgorithm(userAlgorithm);
+      userMean.setMaximumError(1e-8);
+      userMean(x);
+      if ((userMean.getIntegrationAlgorithm().getImplementation().get() != userAlgorithm.getImplementation().get()) || (userMean.getLastError().getDimension() != 0))
+        throw InternalException(HERE) << "The iterated quadrature set by the user has been replaced";
+    }
+    // The smoothed chance measures have analytical gradients
+    {
+      IndividualChanceMeasure individual(f, Normal(1.0, 1.0), GreaterOrEqual(), Point(1, 0.95));
+      individual.setSmoothingBandwidth(0.1);
+      JointChanceMeasure joint(f, Normal(1.0, 1.0), GreaterOrEqual(), 0.95);
+      joint.setSmoothingBandwidth(0.1);
+      Collection <MeasureEvaluation> smoothed;
+      smoothed.add(individual);
+      smoothed.add(joint);
+      MeasureFactory factory(GaussProductExperiment(Indices(1, 4)));
+      for (UnsignedInteger i = 0; i < smoothed.getSize(); ++ i)
+      {
+        const MeasureEvaluation discretizedMeasure(factory.build(smoothed[i]));
+        const Matrix gradient(discretizedMeasure.gradient(x));
+        const Matrix fdGradient(CenteredFiniteDifferenceGradient(ResourceMap::GetAsScalar("CenteredFiniteDifferenceGradient-DefaultEpsilon"), Evaluation(discretizedMeasure.getImplementation())).gradient(x));
+        if (std::abs(gradient(0, 0) - fdGradient(0, 0)) > 1e-5 * (1.0 + std::abs(fdGradient(0, 0))))
+          throw InternalException(HERE) << "Gradient " << gradient << " differs from finite differences " << fdGradient;
+      }
+    }
+    // The smoothing bandwidth shrinks along its schedule down to the final bandwidth
+    {
+      JointChanceMeasure joint(f, Normal(1.0, 1.0), GreaterOrEqual(), 0.95);
+      joint.setSmoothingBandwidth(0.1);
+      joint.setFinalSmoothingBandwidth(0.02);
+      joint.setSmoothingBandwidthReductionFactor(0.5);
+      UnsignedInteger stepsNumber = 0;
+      while (joint.reduceSmoothingBandwidth()) ++ stepsNumber;
+      if ((stepsNumber != 3) || (std::abs(joint.getSmoothingBandwidth() - 0.02) > 1e-15))
+        throw InternalException(HERE) << "Smoothing bandwidth schedule of " << stepsNumber << " steps";
+    }
   }
   // Second test: theta of dimension 2
   {
@@ -104,5 +292,110 @@ int main()
       }
     }
   }
+  // The inner optimizations of the worst case over a double well, whose right well holds the mean
+  {
+    Description input(2);
+    input[0] = "x";
+    input[1] = "theta";
+    const ParametricFunction f(SymbolicFunction(input, Description(1, "(theta^2-4)^2+x*theta")), Indices(1, 1), Point(1, 1.0));
+    const Uniform thetaDist(-3.0, 5.0);
+    const Point x(1, 1.0);
+    // The single start from the mean only finds the local minimum near 2
+    WorstCaseMeasure singleStart(f, thetaDist);
+    singleStart.setStartingPointsNumber(1);
+    const Scalar localMinimum = singleStart(x)[0];
+    // Several starts reach the global minimum near -2
+    WorstCaseMeasure multiStart(f, thetaDist);
+    multiStart.setStartingPointsNumber(8);
+    const Scalar globalMinimum = multiStart(x)[0];
+    if (!(localMinimum > 1.9) || !(globalMinimum < -1.9))
+      throw InternalException(HERE) << "Multi-start worst case " << globalMinimum << " does not improve on the single start " << localMinimum;
+    // The solve warm-started from the optimum at a neighbouring point matches the cold solve
+    WorstCaseMeasure warmStart(multiStart);
+    warmStart.setWarmStartCacheSize(4);
+    warmStart(x);
+    const Point xNext(1, 1.05);
+    const Scalar warmMinimum = warmStart(xNext)[0];
+    const Scalar coldMinimum = multiStart(xNext)[0];
+    if (std::abs(warmMinimum - coldMinimum) > 1e-4)
+      throw InternalException(HERE) << "Warm-started worst case " << warmMinimum << " differs from the cold one " << coldMinimum;
+  }
+  // Third test: the integration algorithms for many parameters, last as the
+  // random shifts of the quasi-Monte Carlo would change the LHS designs printed above
+  {
+    Normal thetaDist(Point(6, 2.0), Point(6, 0.1), IdentityMatrix(6));
+    Description input(Description::BuildDefault(7, "theta"));
+    input[0] = "x";
+    SymbolicFunction f_base(input, Description(1, "x*(theta1+theta2+theta3+theta4+theta5+theta6)"));
+    Indices indices(6);
+    indices.fill(1);
+    ParametricFunction f(f_base, indices, thetaDist.getMean());
+
+    Point x(1, 1.0);
+
+    // The nodes are drawn from the distribution of the measure
+    MeanMeasure mean(f, thetaDist);
+    mean.setIntegrationAlgorithm(QuasiMonteCarloIntegration(1024));
+    if (std::abs(mean(x)[0] - 12.0) > 1e-2)
+      throw InternalException(HERE) << "Quasi-Monte Carlo mean " << mean(x) << " differs from 12";
+    // The replications of the nodes estimate the error
+    if ((mean.getLastError().getDimension() != 1) || !(mean.getLastError()[0] < 1e-2))
+      throw InternalException(HERE) << "Quasi-Monte Carlo error " << mean.getLastError() << " is not estimated";
+    // The PDF threshold only prunes the nodes in the tails, not the small masses of the nodes
+    mean.setPDFThreshold(1e-3);
+    if (std::abs(mean(x)[0] - 12.0) > 1e-2)
+      throw InternalException(HERE) << "Quasi-Monte Carlo mean " << mean(x) << " with a PDF threshold differs from 12";
+    // The sparse grid refines the dimensions of a smooth integrand
+    const ParametricFunction g(SymbolicFunction(Description::BuildDefault(3, "t"), Description(1, "t0*t1+t2")), Indices({1, 2}), Point(2, 2.0));
+    MeanMeasure sparseMean(g, Normal(Point(2, 2.0), Point(2, 0.1), IdentityMatrix(2)));
+    sparseMean.setIntegrationAlgorithm(SparseGridIntegration(1e-8));
+    if (std::abs(sparseMean(x)[0] - 4.0) > 1e-6)
+      throw InternalException(HERE) << "Sparse grid mean " << sparseMean(x) << " differs from 4";
+    // The nodes of a fixed rule and their probabilities are computed once for all the design points
+    MeanMeasure ruleMean(g, Normal(Point(2, 2.0), Point(2, 0.1), IdentityMatrix(2)));
+    ruleMean.setIntegrationAlgorithm(GaussLegendre(Indices(2, 8)));
+    if (std::abs(ruleMean(x)[0] - 4.0) > 1e-6)
+      throw InternalException(HERE) << "Gauss-Legendre mean " << ruleMean(x) << " differs from 4";
+    if (Point(ruleMean(Sample(2, x))[1]) != ruleMean(x))
+      throw InternalException(HERE) << "Gauss-Legendre sample evaluation differs from point evaluation";
+    // The first-order Taylor control variate is exact for a function linear in the parameters
+    MeanMeasure controlMean(g, Normal(Point(2, 2.0), Point(2, 0.1), IdentityMatrix(2)));
+    controlMean.setControlVariate(true);
+    VarianceMeasure controlVariance(g, Normal(Point(2, 2.0), Point(2, 0.1), IdentityMatrix(2)));
+    controlVariance.setControlVariate(true);
+    const MeasureFactory controlFactory(MonteCarloExperiment(100));
+    const MeasureEvaluation discretizedMean(controlFactory.build(controlMean));
+    const MeasureEvaluation discretizedVariance(controlFactory.build(controlVariance));
+    if ((std::abs(discretizedMean(x)[0] - 4.0) > 1e-10) || !(discretizedMean.getLastVarianceReduction()[0] < 1e-10))
+      throw InternalException(HERE) << "Control variate mean " << discretizedMean(x) << " with reduction " << discretizedMean.getLastVarianceReduction() << " differs from 4";
+    if (std::abs(discretizedVariance(x)[0] - 0.02) > 1e-10)
+      throw InternalException(HERE) << "Control variate variance " << discretizedVariance(x) << " differs from 0.02";
+    if (Point(discretizedMean(Sample(2, x))[1]) != discretizedMean(x))
+      throw InternalException(HERE) << "Control variate sample evaluation differs from point evaluation";
+    // Rare chance measures by importance sampling, the proposal adapted at x is reused at the neighbouring x
+    const ParametricFunction h(SymbolicFunction(Description::BuildDefault(3, "t"), Description(1, "t1+t2-t0")), Indices({1, 2}), Point(2, 0.0));
+    const Normal standard(2);
+    JointChanceMeasure rareJoint(h, standard, GreaterOrEqual(), 1e-5);
+    rareJoint.setImportanceSamplingSize(2000);
+    // which takes precedence over the nodes of a fixed rule, for a sample too
+    rareJoint.setIntegrationAlgorithm(GaussLegendre(Indices(2, 8)));
+    const ParametricFunction hComplement(SymbolicFunction(Description::BuildDefault(3, "t"), Description(1, "t0-t1-t2")), Indices({1, 2}), Point(2, 0.0));
+    IndividualChanceMeasure rareIndividual(hComplement, standard, GreaterOrEqual(), Point(1, 1.0 - 1e-5));
+    rareIndividual.setImportanceSamplingSize(2000);
+    for (UnsignedInteger i = 0; i < 2; ++ i)
+    {
+      const Point xRare(1, 6.0 + 0.1 * i);
+      const Scalar reference = DistFunc::pNormal(-xRare[0] / std::sqrt(2.0));
+      const Scalar jointProbability = rareJoint(xRare)[0] + 1e-5;
+      if ((std::abs(jointProbability - reference) > 0.1 * reference) || !(rareJoint.getLastError()[0] < 0.1 * reference))
+        throw InternalException(HERE) << "Importance sampling probability " << jointProbability << " with error " << rareJoint.getLastError() << " differs from " << reference;
+      const Scalar sampleProbability = rareJoint(Sample(1, xRare))(0, 0) + 1e-5;
+      if (std::abs(sampleProbability - reference) > 0.1 * reference)
+        throw InternalException(HERE) << "Importance sampling sample probability " << sampleProbability << " differs from " << reference;
+      const Scalar individualProbability = rareIndividual(xRare)[0] + 1.0 - 1e-5;
+      if (std::abs(1.0 - individualProbability - reference) > 0.1 * reference)
+        throw InternalException(HERE) << "Importance sampling complementary probability " << 1.0 - individualProbability << " differs from " << reference;
+    }
+  }
 }
 
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <iomanip>
+
+#include "otrobopt/OTRobOpt.hxx"
+#include "openturns/OT.hxx"
+
+
+using namespace OT;
+using namespace OTROBOPT;
+
+int main()
+{
+  QuasiMonteCarloIntegration algorithm(65536, HaltonSequence());
+  std::cout << "size=" << algorithm.getSize() << " replicationsNumber=" << algorithm.getReplicationsNumber() << std::endl;
+
+  // The nodes are uniform over the interval, split into the replications
+  const Interval interval(0.0, 3.0);
+  Point weights;
+  const Sample nodes(algorithm.generateWithWeights(interval, weights));
+  std::cout << "nodes=" << nodes.getSize() << " weights sum=" << std::setprecision(6) << weights.norm1() << std::endl;
+
+  // The error is the standard deviation of the estimate over the replications
+  Point error;
+  const Point integral(algorithm.integrate(SymbolicFunction(Description(1, "t"), Description(1, "t^2")), interval, error));
+  if ((std::abs(integral[0] - 9.0) > 1e-2) || !(error[0] < 1e-2))
+    throw InternalException(HERE) << "Quasi-Monte Carlo integral " << integral << " with error " << error << " differs from 9";
+  std::cout << "integral=" << std::setprecision(2) << integral[0] << std::endl;
+
+  // A single replication is the plain sequence, without error estimate
+  algorithm.setReplicationsNumber(1);
+  const Point plainIntegral(algorithm.integrate(SymbolicFunction(Description(1, "t"), Description(1, "t^2")), interval, error));
+  if ((std::abs(plainIntegral[0] - 9.0) > 1e-2) || (error[0] != 0.0))
+    throw InternalException(HERE) << "Plain quasi-Monte Carlo integral " << plainIntegral << " with error " << error << " differs from 9";
+  std::cout << "plain integral=" << std::setprecision(2) << plainIntegral[0] << " error=" << error[0] << std::endl;
+
+  // The nodes can be drawn from a distribution, the integrand is then divided by its density
+  QuasiMonteCarloIntegration normalAlgorithm(4096);
+  normalAlgorithm.setDistribution(Normal(2.0, 0.5));
+  const Point normalIntegral(normalAlgorithm.integrate(SymbolicFunction(Description(1, "t"), Description(1, "t*exp(-(t-2)^2/0.5)/sqrt(0.5*_pi)")), Interval(-2.0, 6.0), error));
+  if ((std::abs(normalIntegral[0] - 2.0) > 1e-2) || !(error[0] < 1e-2))
+    throw InternalException(HERE) << "Quasi-Monte Carlo integral " << normalIntegral << " with error " << error << " differs from 2";
+  std::cout << "normal integral=" << std::setprecision(2) << normalIntegral[0] << std::endl;
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <iomanip>
+
+#include "otrobopt/OTRobOpt.hxx"
+#include "openturns/OT.hxx"
+
+
+using namespace OT;
+using namespace OTROBOPT;
+
+int main()
+{
+  SparseGridIntegration algorithm(1e-8);
+  std::cout << algorithm << std::endl;
+
+  // The nested Clenshaw-Curtis rules are exact for the polynomials of low degree
+  Point error;
+  const Point polynomialIntegral(algorithm.integrate(SymbolicFunction(Description::BuildDefault(2, "t"), Description(1, "t0^2*t1")), Interval(Point(2, 0.0), Point(2, 1.0)), error));
+  if ((std::abs(polynomialIntegral[0] - 1.0 / 6.0) > 1e-12) || !(error[0] <= 1e-8))
+    throw InternalException(HERE) << "Sparse grid integral " << polynomialIntegral << " with error " << error << " differs from 1/6";
+  std::cout << "polynomial integral=" << std::setprecision(6) << polynomialIntegral[0] << std::endl;
+
+  // The sparse grid refines the dimensions of a smooth integrand
+  const Point integral(algorithm.integrate(SymbolicFunction(Description::BuildDefault(5, "t"), Description(1, "exp(t0+t1+t2+t3+t4)")), Interval(Point(5, 0.0), Point(5, 1.0)), error));
+  if ((std::abs(integral[0] - std::pow(std::exp(1.0) - 1.0, 5.0)) > 1e-6) || !(error[0] <= 1e-8))
+    throw InternalException(HERE) << "Sparse grid integral " << integral << " with error " << error << " differs from (e-1)^5";
+  std::cout << "exponential integral=" << std::setprecision(6) << integral[0] << std::endl;
+
+  // Over any interval
+  const Point scaledIntegral(algorithm.integrate(SymbolicFunction(Description(1, "t"), Description(1, "exp(t)")), Interval(-1.0, 2.0), error));
+  if ((std::abs(scaledIntegral[0] - (std::exp(2.0) - std::exp(-1.0))) > 1e-6) || !(error[0] <= 1e-8))
+    throw InternalException(HERE) << "Sparse grid integral " << scaledIntegral << " with error " << error << " differs from exp(2)-exp(-1)";
+  std::cout << "scaled integral=" << std::setprecision(6) << scaledIntegral[0] << std::endl;
+  return 0;
+}
@@ -0,0 +1,10 @@
+// SWIG file
+
+%{
+#include "otrobopt/AdaptiveIntegrationRobustAlgorithm.hxx"
+%}
+
+%include AdaptiveIntegrationRobustAlgorithm_doc.i
+
+%copyctor OTROBOPT::AdaptiveIntegrationRobustAlgorithm;
+%include otrobopt/AdaptiveIntegrationRobustAlgorithm.hxx
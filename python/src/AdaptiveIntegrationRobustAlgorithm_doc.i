@@ -0,0 +1,99 @@
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm
+"Adaptive integration robust optimization algorithm.
+
+Solves a robust optimization problem on continuous measures by successive
+deterministic problems, whose measures are integrated with an accuracy
+tightened from one step to the next.
+
+The first step integrates the measures with the accuracy set by
+:py:meth:`setInitialMaximumError`, which is then reduced at least by the factor
+set by :py:meth:`setErrorReductionFactor`, and down to the residual error
+reached by the solver, until it reaches :py:meth:`setFinalMaximumError`.
+Each step starts from the optimum of the previous one and the inner solver,
+set by :py:meth:`setOptimizationAlgorithm`, stops as soon as its residuals
+are below the accuracy of the integration, so that the early steps cost a
+fraction of a fully accurate solve.
+
+After each step the smoothed chance measures reduce their bandwidth along
+their schedule, see :py:meth:`otrobopt.JointChanceMeasure.setFinalSmoothingBandwidth`.
+
+The algorithm stops when the number of iterations has been reached or the
+absolute error is small enough with the final accuracy and the final
+smoothing bandwidths.
+
+Parameters
+----------
+problem : :class:`~otrobopt.RobustOptimizationProblem`
+    Robust optimization problem
+solver : :py:class:`openturns.OptimizationAlgorithm`
+    Optimization solver
+
+See also
+--------
+otrobopt.MeasureEvaluation.setMaximumError"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::setInitialMaximumError
+"Initial maximum error accessor.
+
+Parameters
+----------
+initialMaximumError : float
+    Integration accuracy of the first step.
+    Default is given by `AdaptiveIntegrationRobustAlgorithm-DefaultInitialMaximumError`
+    from the :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::getInitialMaximumError
+"Initial maximum error accessor.
+
+Returns
+-------
+initialMaximumError : float
+    Integration accuracy of the first step."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::setFinalMaximumError
+"Final maximum error accessor.
+
+Parameters
+----------
+finalMaximumError : float
+    Integration accuracy of the last steps.
+    Default is given by `AdaptiveIntegrationRobustAlgorithm-DefaultFinalMaximumError`
+    from the :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::getFinalMaximumError
+"Final maximum error accessor.
+
+Returns
+-------
+finalMaximumError : float
+    Integration accuracy of the last steps."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::setErrorReductionFactor
+"Error reduction factor accessor.
+
+Parameters
+----------
+errorReductionFactor : float, in :math:`(0, 1)`
+    Minimal reduction of the integration accuracy between two steps.
+    Default is given by `AdaptiveIntegrationRobustAlgorithm-DefaultErrorReductionFactor`
+    from the :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::AdaptiveIntegrationRobustAlgorithm::getErrorReductionFactor
+"Error reduction factor accessor.
+
+Returns
+-------
+errorReductionFactor : float
+    Minimal reduction of the integration accuracy between two steps."
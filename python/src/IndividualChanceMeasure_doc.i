@@ -64,3 +64,122 @@ Returns
 -------
 alpha : sequence of float in :math:`(0,1)`
     Probability levels"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::setSmoothingBandwidth
+R"RAW(Smoothing bandwidth accessor.
+
+When the bandwidth :math:`h` is positive, the indicator :math:`\mathbf{1}_{f_k \ge 0}`
+is replaced by :math:`\Phi(f_k / h)` where :math:`\Phi` is the standard normal CDF.
+The measure becomes differentiable and its gradient is computed analytically.
+The bandwidth is meant to be decreased between successive optimizations
+to approach the hard constraint. A bandwidth of 0 keeps the indicator.
+The default value is given by the `IndividualChanceMeasure-SmoothingBandwidth` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+h : float, :math:`h \geq 0`
+    Smoothing bandwidth)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::getSmoothingBandwidth
+"Smoothing bandwidth accessor.
+
+Returns
+-------
+h : float
+    Smoothing bandwidth"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::setFinalSmoothingBandwidth
+R"RAW(Final smoothing bandwidth accessor.
+
+The smoothing bandwidth follows a schedule: each call to
+:meth:`reduceSmoothingBandwidth` multiplies it by the reduction factor, down
+to the final bandwidth :math:`h_f`. The schedule is driven by
+:class:`~otrobopt.AdaptiveIntegrationRobustAlgorithm` after each step.
+A final bandwidth of 0 disables the schedule.
+The default value is given by the `IndividualChanceMeasure-FinalSmoothingBandwidth` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+h_f : float, :math:`h_f \geq 0`
+    Final smoothing bandwidth)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::getFinalSmoothingBandwidth
+"Final smoothing bandwidth accessor.
+
+Returns
+-------
+h_f : float
+    Final smoothing bandwidth"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::setSmoothingBandwidthReductionFactor
+"Smoothing bandwidth reduction factor accessor.
+
+The default value is given by the `IndividualChanceMeasure-SmoothingBandwidthReductionFactor` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+factor : float in :math:`(0, 1)`
+    Factor applied to the smoothing bandwidth at each step of the schedule"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::getSmoothingBandwidthReductionFactor
+"Smoothing bandwidth reduction factor accessor.
+
+Returns
+-------
+factor : float
+    Factor applied to the smoothing bandwidth at each step of the schedule"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::reduceSmoothingBandwidth
+OTROBOPT_MeasureEvaluation_reduceSmoothingBandwidth_doc
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::setImportanceSamplingSize
+R"RAW(Importance sampling size accessor.
+
+When the size :math:`N` is positive and the distribution is continuous, the
+probability of the event that each output is nonnegative is estimated by importance sampling
+with :math:`N` nodes instead of being integrated. The proposal is a gaussian
+distribution with independent components, adapted by cross-entropy towards the
+event when :math:`\alpha_k \leq 1/2` and towards its complement otherwise, which
+suits the small failure probabilities of reliability constraints.
+The adapted proposal is kept for the next evaluations, and the standard
+deviation of the estimate is given by :meth:`getLastError`.
+The number of levels of the adaptation is bounded by the
+`MeasureEvaluation-ImportanceSamplingMaximumLevelsNumber` key and the fraction
+of nodes retained at each level by the `MeasureEvaluation-ImportanceSamplingQuantileLevel` key.
+A size of 0 disables the importance sampling.
+The default value is given by the `IndividualChanceMeasure-ImportanceSamplingSize` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+size : int
+    Importance sampling size)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::IndividualChanceMeasure::getImportanceSamplingSize
+"Importance sampling size accessor.
+
+Returns
+-------
+size : int
+    Importance sampling size"
@@ -36,3 +36,35 @@ Examples
 >>> print(measure(x))
 [2])RAW"
 
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::MeanMeasure::setControlVariate
+R"RAW(Taylor control variate accessor.
+
+When enabled, the mean over the nodes of a discrete distribution, of a
+discretization or of a fixed integration rule is corrected by the first-order
+Taylor expansion :math:`g(\theta) = f(x, \mu) + \nabla_\theta f(x, \mu)^T (\theta - \mu)`
+where :math:`\mu` and :math:`\Sigma` are the mean and covariance of the
+continuous distribution approximated by the nodes. With the coefficient
+:math:`c` fitted by weighted regression of :math:`f` on :math:`g` over the same
+nodes, the estimate becomes
+:math:`\sum_i w_i f(x, \theta_i) - c \left(\sum_i w_i g(\theta_i) - f(x, \mu)\right)`.
+The ratio of the residual variance to the variance of the values is given by
+:meth:`getLastVarianceReduction`. The gradient and the hessian are not corrected.
+The default value is given by the `MeanMeasure-ControlVariate` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+controlVariate : bool
+    Whether the Taylor control variate is used)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::MeanMeasure::getControlVariate
+"Taylor control variate accessor.
+
+Returns
+-------
+controlVariate : bool
+    Whether the Taylor control variate is used"
@@ -60,5 +60,9 @@ canConvert< _PyObject_, OTROBOPT::MeasureEvaluation >(PyObject * pyObj)
 
 TypedInterfaceObjectImplementationHelper(OTROBOPT, MeasureEvaluation, MeasureEvaluationImplementation)
 
+// the evaluation cache is shared internally by the measures
+%ignore OTROBOPT::MeasureEvaluation::setEvaluationCache;
+%ignore OTROBOPT::MeasureEvaluation::getEvaluationCache;
+
 %copyctor OTROBOPT::MeasureEvaluation;
 %include otrobopt/MeasureEvaluation.hxx
@@ -6,5 +6,9 @@
 
 %include MeasureEvaluationImplementation_doc.i
 
+// the evaluation cache is shared internally by the measures
+%ignore OTROBOPT::MeasureEvaluationImplementation::setEvaluationCache;
+%ignore OTROBOPT::MeasureEvaluationImplementation::getEvaluationCache;
+
 %copyctor OTROBOPT::MeasureEvaluationImplementation;
 %include otrobopt/MeasureEvaluationImplementation.hxx
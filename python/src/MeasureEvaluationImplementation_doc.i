@@ -69,6 +69,16 @@ OTROBOPT_MeasureEvaluation_getFunction_doc
 %define OTROBOPT_MeasureEvaluation_setIntegrationAlgorithm_doc
 "Integration algorithm accessor.
 
+The iterated quadratures used by default become too expensive beyond a few
+uncertain parameters. A :class:`~otrobopt.SparseGridIntegration` suits smooth
+integrands in moderate dimensions, and a :class:`~otrobopt.QuasiMonteCarloIntegration`
+higher dimensions: its nodes are drawn from the distribution of the measure.
+
+The nodes of a :class:`~otrobopt.QuasiMonteCarloIntegration` or of a
+:py:class:`openturns.GaussLegendre` rule do not depend on the design point:
+they are computed once along with their probabilities, and the measure is
+then reduced over them as over the support of a discrete distribution.
+
 Parameters
 ----------
 algorithm : :py:class:`openturns.IntegrationAlgorithm`
@@ -117,3 +127,135 @@ threshold : float
 OTROBOPT_MeasureEvaluation_setPDFThreshold_doc
 
 // ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_setMaximumError_doc
+"Maximum error accessor.
+
+Applied to the :py:class:`openturns.GaussKronrod` and
+:py:class:`~otrobopt.SparseGridIntegration` algorithms, and to the inner
+rule of the default :py:class:`openturns.IteratedQuadrature` of the measure.
+An iterated quadrature set by the user is left unchanged as its inner rule
+is not accessible, and the accuracy of a
+:py:class:`~otrobopt.QuasiMonteCarloIntegration` is set by its number of
+nodes.
+
+Parameters
+----------
+maximumError : float
+    Requested accuracy of the integration over a continuous distribution."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::setMaximumError
+OTROBOPT_MeasureEvaluation_setMaximumError_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_getMaximumError_doc
+"Maximum error accessor.
+
+Returns
+-------
+maximumError : float
+    Requested accuracy of the integration over a continuous distribution."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::getMaximumError
+OTROBOPT_MeasureEvaluation_getMaximumError_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_getLastError_doc
+"Error estimate of the last evaluation.
+
+It is estimated by the integration algorithm. The default iterated
+quadrature only estimates it for a parameter of dimension 1, through its
+inner rule, the error of the other iterated quadratures is unknown. It is
+propagated to the variance and the standard deviation at first order.
+With a :class:`~otrobopt.QuasiMonteCarloIntegration` algorithm it is the
+standard deviation of the measure over the replications of the nodes.
+
+Returns
+-------
+error : :py:class:`openturns.Point`
+    Error estimate of each output of the last evaluation over a continuous
+    distribution, empty if it is unknown or if the measure is reduced over
+    the nodes of a fixed rule."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::getLastError
+OTROBOPT_MeasureEvaluation_getLastError_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_getLastVarianceReduction_doc
+"Variance reduction of the control variate at the last evaluation.
+
+Returns
+-------
+reduction : :py:class:`openturns.Point`
+    Ratio of the residual variance to the variance of each output of the
+    function over the nodes, empty if no control variate was used."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::getLastVarianceReduction
+OTROBOPT_MeasureEvaluation_getLastVarianceReduction_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_reduceSmoothingBandwidth_doc
+"Next step of the smoothing bandwidth schedule.
+
+Only the chance measures with a smoothing bandwidth schedule reduce their
+bandwidth, an aggregated measure reduces the bandwidths of its members.
+
+Returns
+-------
+reduced : bool
+    Whether the bandwidth was reduced, false if the measure has no schedule
+    or its bandwidth already reached its final value."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::reduceSmoothingBandwidth
+OTROBOPT_MeasureEvaluation_reduceSmoothingBandwidth_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_gradient_doc
+"Gradient with respect to :math:`x`.
+
+It is analytical for the mean, variance and mean/standard deviation trade-off
+measures. For the worst-case measure it is the gradient of the function at the
+worst-case parameter, by the envelope theorem. For the quantile measure it is
+the expectation of the gradient of the function conditionally to being equal to
+the quantile, estimated with a gaussian kernel. It is analytical for the chance
+measures with a positive smoothing bandwidth. It is computed by centered finite
+differences otherwise.
+
+Parameters
+----------
+x : sequence of float
+    Design point.
+
+Returns
+-------
+gradient : :py:class:`openturns.Matrix`
+    Gradient of the measure, with one row per input and one column per output."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::gradient
+OTROBOPT_MeasureEvaluation_gradient_doc
+
+// ---------------------------------------------------------------------
+
+%define OTROBOPT_MeasureEvaluation_hessian_doc
+"Hessian with respect to :math:`x`.
+
+It is analytical for the mean and variance measures, and computed by centered
+finite differences otherwise.
+
+Parameters
+----------
+x : sequence of float
+    Design point.
+
+Returns
+-------
+hessian : :py:class:`openturns.SymmetricTensor`
+    Hessian of the measure, one sheet per output."
+%enddef
+%feature("docstring") OTROBOPT::MeasureEvaluationImplementation::hessian
+OTROBOPT_MeasureEvaluation_hessian_doc
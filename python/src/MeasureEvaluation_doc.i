@@ -18,3 +18,17 @@ OTROBOPT_MeasureEvaluation_getIntegrationAlgorithm_doc
 OTROBOPT_MeasureEvaluation_setPDFThreshold_doc
 %feature("docstring") OTROBOPT::MeasureEvaluation::getPDFThreshold
 OTROBOPT_MeasureEvaluation_getPDFThreshold_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::setMaximumError
+OTROBOPT_MeasureEvaluation_setMaximumError_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::getMaximumError
+OTROBOPT_MeasureEvaluation_getMaximumError_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::getLastError
+OTROBOPT_MeasureEvaluation_getLastError_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::getLastVarianceReduction
+OTROBOPT_MeasureEvaluation_getLastVarianceReduction_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::reduceSmoothingBandwidth
+OTROBOPT_MeasureEvaluation_reduceSmoothingBandwidth_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::gradient
+OTROBOPT_MeasureEvaluation_gradient_doc
+%feature("docstring") OTROBOPT::MeasureEvaluation::hessian
+OTROBOPT_MeasureEvaluation_hessian_doc
@@ -0,0 +1,10 @@
+// SWIG file MeasureGradient.i
+
+%{
+#include "otrobopt/MeasureGradient.hxx"
+%}
+
+%include MeasureGradient_doc.i
+
+%copyctor OTROBOPT::MeasureGradient;
+%include otrobopt/MeasureGradient.hxx
@@ -0,0 +1,21 @@
+%feature("docstring") OTROBOPT::MeasureGradient
+"Measure function gradient.
+
+The gradient with respect to :math:`x` is analytical for the mean, variance
+and mean/standard deviation trade-off measures, and is computed by finite
+differences for the other measures.
+
+Parameters
+----------
+evaluation : :class:`~otrobopt.MeasureEvaluation`
+    Measure evaluation
+
+Examples
+--------
+>>> import openturns as ot
+>>> import otrobopt
+>>> thetaDist = ot.Normal(2.0, 0.1)
+>>> f = ot.SymbolicFunction(['x', 'theta'], ['x*theta'])
+>>> parametric = ot.ParametricFunction(f, [1], [1.0])
+>>> evaluation = otrobopt.MeanMeasure(parametric, thetaDist)
+>>> gradient = otrobopt.MeasureGradient(evaluation)"
@@ -0,0 +1,10 @@
+// SWIG file MeasureHessian.i
+
+%{
+#include "otrobopt/MeasureHessian.hxx"
+%}
+
+%include MeasureHessian_doc.i
+
+%copyctor OTROBOPT::MeasureHessian;
+%include otrobopt/MeasureHessian.hxx
@@ -7,6 +7,12 @@ It is built from a parametric function :math:`f` and a distribution :math:`\cD`
 
     M_{f, \cD, \alpha}(x) = \inf \{ s \in \Rset \: | \: \Pset (f(x, \Theta) \leq s) \geq \alpha \}
 
+Its gradient :math:`\Eset(\nabla_x f(x, \Theta) \: | \: f(x, \Theta) = M_{f, \cD, \alpha}(x))` is estimated
+with a gaussian kernel of bandwidth :math:`h = \sigma \max(r, 1.06 n^{-1/5})`, where :math:`\sigma` is the
+standard deviation of :math:`f(x, \Theta)`, :math:`n` the effective number of nodes of a discrete distribution
+or a fixed rule, infinite for an adaptive integration, and :math:`r` is given by the
+`QuantileMeasure-RelativeBandwidth` key of the :class:`openturns.ResourceMap`.
+
 Parameters
 ----------
 function : :py:class:`openturns.Function`
@@ -47,3 +53,36 @@ Returns
 -------
 alpha : float
     Quantile level"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuantileMeasure::setSingleSweep
+"Single sweep accessor.
+
+Parameters
+----------
+singleSweep : bool
+    Whether the quantile of a continuous distribution is the weighted
+    quantile of the function values at the nodes of a tensorized
+    Gauss-Legendre rule with at most `QuantileMeasure-SingleSweepNodesNumber`
+    nodes from the :py:class:`openturns.ResourceMap`, instead of the root of
+    the cumulative distribution function integrated at each iteration. The
+    nodes are computed once, and the function is then evaluated once per
+    node. There are at least 2 nodes per axis, so :math:`2^d` nodes when
+    the number of nodes is below :math:`2^d`. It only applies to the adaptive
+    integration algorithms, the nodes of a
+    :py:class:`~otrobopt.QuasiMonteCarloIntegration` or of a
+    :py:class:`openturns.GaussLegendre` algorithm are always used this way.
+    Default is given by `QuantileMeasure-SingleSweep`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuantileMeasure::getSingleSweep
+"Single sweep accessor.
+
+Returns
+-------
+singleSweep : bool
+    Whether the quantile of a continuous distribution is the weighted
+    quantile of the function values at the nodes of a tensorized
+    Gauss-Legendre rule."
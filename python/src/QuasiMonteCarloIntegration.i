@@ -0,0 +1,26 @@
+// SWIG file QuasiMonteCarloIntegration.i
+
+%{
+#include "otrobopt/QuasiMonteCarloIntegration.hxx"
+%}
+
+%include QuasiMonteCarloIntegration_doc.i
+
+%ignore OTROBOPT::QuasiMonteCarloIntegration::integrate(const OT::Function & function, const OT::Interval & interval, OT::Point & error) const;
+
+%typemap(in, numinputs=0) OT::Point & weights ($*ltype temp) %{ temp = OT::Point(); $1 = &temp; %}
+%typemap(argout) OT::Point & weights %{ $result = SWIG_Python_AppendOutput($result, SWIG_NewPointerObj(new OT::Point(*$1), SWIG_TypeQuery("OT::Point *"), SWIG_POINTER_OWN |  0 )); %}
+
+%copyctor OTROBOPT::QuasiMonteCarloIntegration;
+%include otrobopt/QuasiMonteCarloIntegration.hxx
+
+%extend OTROBOPT::QuasiMonteCarloIntegration {
+
+PyObject * integrateWithError(const OT::Function & function, const OT::Interval & interval) const
+{
+  OT::Point error;
+  const OT::Point integral(self->integrate(function, interval, error));
+  return Py_BuildValue("(NN)", OT::convert<OT::Point, OT::_PySequence_>(integral), OT::convert<OT::Point, OT::_PySequence_>(error));
+}
+
+}
@@ -0,0 +1,193 @@
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration
+R"RAW(Randomized quasi-Monte Carlo integration.
+
+The integral of :math:`g` over the interval :math:`I` is estimated with low
+discrepancy points :math:`u_i` of the unit cube, mapped to nodes
+:math:`\theta_i = T^{-1}(u_i)` of a distribution :math:`\cD` of density
+:math:`p` through its inverse iso-probabilistic transformation:
+
+.. math::
+
+    \int_I g(\theta) d\theta \approx \frac{1}{N} \sum_{i=1}^N \frac{g(\theta_i)}{p(\theta_i)} 1_I(\theta_i)
+
+The points are shifted modulo 1 by :math:`R` random vectors drawn once, and the
+standard deviation of the :math:`R` estimates gives the error. The cost is
+linear in the number of nodes whatever the dimension, which makes it suited to
+measures with many uncertain parameters where the iterated quadratures are
+too expensive.
+
+When used by a measure through
+:meth:`~otrobopt.MeasureEvaluation.setIntegrationAlgorithm`, the distribution
+is the one of the measure. Otherwise the nodes are uniform over the interval.
+
+Parameters
+----------
+size : int
+    Total number of nodes, split between the replications.
+    Default is given by the `QuasiMonteCarloIntegration-DefaultSize` key of
+    :py:class:`openturns.ResourceMap`.
+sequence : :py:class:`openturns.LowDiscrepancySequence`, optional
+    Low discrepancy sequence, :py:class:`openturns.SobolSequence` by default.
+
+Examples
+--------
+>>> import openturns as ot
+>>> import otrobopt
+>>> thetaDist = ot.Normal([2.0] * 6, [0.1] * 6, ot.CorrelationMatrix(6))
+>>> f_base = ot.SymbolicFunction(['x', 't0', 't1', 't2', 't3', 't4', 't5'], ['x*(t0+t1+t2+t3+t4+t5)'])
+>>> f = ot.ParametricFunction(f_base, [1, 2, 3, 4, 5, 6], [1.0] * 6)
+>>> measure = otrobopt.MeanMeasure(f, thetaDist)
+>>> measure.setIntegrationAlgorithm(otrobopt.QuasiMonteCarloIntegration(4096, ot.HaltonSequence()))
+>>> mean = measure([1.0])
+)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::integrate
+"Compute the integral over an interval.
+
+Parameters
+----------
+function : :py:class:`openturns.Function`
+    Integrand.
+interval : :py:class:`openturns.Interval`
+    Domain of integration.
+
+Returns
+-------
+integral : :py:class:`openturns.Point`
+    Mean of the estimates of the replications."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::integrateWithError
+"Compute the integral over an interval and its error.
+
+Parameters
+----------
+function : :py:class:`openturns.Function`
+    Integrand.
+interval : :py:class:`openturns.Interval`
+    Domain of integration.
+
+Returns
+-------
+integral : sequence of float
+    Mean of the estimates of the replications.
+error : sequence of float
+    Standard deviation of this mean, zero for a single replication."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::generateWithWeights
+"Generate the nodes and their weights in the estimate of the integral.
+
+Parameters
+----------
+interval : :py:class:`openturns.Interval`
+    Domain of integration.
+
+Returns
+-------
+nodes : :py:class:`openturns.Sample`
+    Nodes of all the replications, stored in consecutive blocks.
+weights : :py:class:`openturns.Point`
+    Weights such that the integral of a function is estimated by the sum
+    of its values at the nodes times the weights. The nodes outside of the
+    interval have a zero weight."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::setSize
+"Number of nodes accessor.
+
+Parameters
+----------
+size : int
+    Total number of nodes, split between the replications."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::getSize
+"Number of nodes accessor.
+
+Returns
+-------
+size : int
+    Total number of nodes, split between the replications."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::setReplicationsNumber
+"Number of replications accessor.
+
+Parameters
+----------
+replicationsNumber : int
+    Number of randomly shifted replications of the sequence.
+    A single replication is the deterministic sequence, without error estimate.
+    Default is given by the `QuasiMonteCarloIntegration-DefaultReplicationsNumber`
+    key of :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::getReplicationsNumber
+"Number of replications accessor.
+
+Returns
+-------
+replicationsNumber : int
+    Number of randomly shifted replications of the sequence."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::setSequence
+"Low discrepancy sequence accessor.
+
+Parameters
+----------
+sequence : :py:class:`openturns.LowDiscrepancySequence`
+    Low discrepancy sequence."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::getSequence
+"Low discrepancy sequence accessor.
+
+Returns
+-------
+sequence : :py:class:`openturns.LowDiscrepancySequence`
+    Low discrepancy sequence."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::setDistribution
+"Distribution of the nodes accessor.
+
+Setting it draws new shifts for the replications.
+
+Parameters
+----------
+distribution : :py:class:`openturns.Distribution`
+    Distribution the nodes are mapped to."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::getDistribution
+"Distribution of the nodes accessor.
+
+Returns
+-------
+distribution : :py:class:`openturns.Distribution`
+    Distribution the nodes are mapped to."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::QuasiMonteCarloIntegration::hasDistribution
+"Whether the distribution of the nodes is set.
+
+Returns
+-------
+hasDistribution : bool
+    Whether the distribution of the nodes is set, otherwise they are uniform
+    over the interval of integration."
@@ -23,6 +23,15 @@ objective : :py:class:`openturns.Function`
 inequalityConstraint : :py:class:`openturns.Function`
     Inequality constraint
 
+Notes
+-----
+When the robustness and the reliability measures have the same function and
+are reduced over the same nodes, the support of the same discrete distribution
+or the nodes of the same fixed integration rule such as
+:py:class:`openturns.GaussLegendre`, they share the evaluations of the function
+at the design points requested by the solver. The measures integrated
+adaptively, as with the default iterated quadrature, evaluate it on their own.
+
 Examples
 --------
 >>> import openturns as ot
@@ -0,0 +1,23 @@
+// SWIG file SparseGridIntegration.i
+
+%{
+#include "otrobopt/SparseGridIntegration.hxx"
+%}
+
+%include SparseGridIntegration_doc.i
+
+%ignore OTROBOPT::SparseGridIntegration::integrate(const OT::Function & function, const OT::Interval & interval, OT::Point & error) const;
+
+%copyctor OTROBOPT::SparseGridIntegration;
+%include otrobopt/SparseGridIntegration.hxx
+
+%extend OTROBOPT::SparseGridIntegration {
+
+PyObject * integrateWithError(const OT::Function & function, const OT::Interval & interval) const
+{
+  OT::Point error;
+  const OT::Point integral(self->integrate(function, interval, error));
+  return Py_BuildValue("(NN)", OT::convert<OT::Point, OT::_PySequence_>(integral), OT::convert<OT::Point, OT::_PySequence_>(error));
+}
+
+}
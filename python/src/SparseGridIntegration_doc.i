@@ -0,0 +1,139 @@
+%feature("docstring") OTROBOPT::SparseGridIntegration
+R"RAW(Dimension-adaptive Smolyak sparse grid integration.
+
+The integral over the interval is the sum over a set :math:`\cK` of
+multi-indices of tensor products of differences of one-dimensional
+Clenshaw-Curtis rules :math:`Q_l` with :math:`1` node at level :math:`0` and
+:math:`2^l+1` nodes above:
+
+.. math::
+
+    \int_I g(\theta) d\theta \approx \sum_{k \in \cK} \bigotimes_{i=1}^d (Q_{k_i} - Q_{k_i - 1}) g
+
+The rules are nested, so the nodes of a level are reused by the finer ones and
+each node is evaluated once. Starting from :math:`\cK = \{0\}`, the index with
+the largest contribution is refined in each dimension, as long as the sum of
+the contributions of the indices not refined yet exceeds the maximum error.
+Only the dimensions that matter get fine rules, which takes far fewer
+evaluations than a tensor quadrature for smooth integrands in moderate
+dimensions.
+
+Parameters
+----------
+maximumError : float
+    Maximum absolute error.
+    Default is given by the `SparseGridIntegration-DefaultMaximumError` key of
+    :py:class:`openturns.ResourceMap`.
+
+Examples
+--------
+>>> import openturns as ot
+>>> import otrobopt
+>>> thetaDist = ot.Normal([2.0] * 2, [0.1] * 2, ot.CorrelationMatrix(2))
+>>> f_base = ot.SymbolicFunction(['x', 't0', 't1'], ['x*t0+t1'])
+>>> f = ot.ParametricFunction(f_base, [1, 2], [1.0] * 2)
+>>> measure = otrobopt.MeanMeasure(f, thetaDist)
+>>> measure.setIntegrationAlgorithm(otrobopt.SparseGridIntegration(1e-6))
+>>> mean = measure([1.0])
+)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::integrate
+"Compute the integral over an interval.
+
+Parameters
+----------
+function : :py:class:`openturns.Function`
+    Integrand.
+interval : :py:class:`openturns.Interval`
+    Domain of integration.
+
+Returns
+-------
+integral : :py:class:`openturns.Point`
+    Approximation of the integral."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::integrateWithError
+"Compute the integral over an interval and its error.
+
+Parameters
+----------
+function : :py:class:`openturns.Function`
+    Integrand.
+interval : :py:class:`openturns.Interval`
+    Domain of integration.
+
+Returns
+-------
+integral : sequence of float
+    Approximation of the integral.
+error : sequence of float
+    Sum of the absolute contributions of the indices not refined yet."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::setMaximumError
+"Maximum error accessor.
+
+Parameters
+----------
+maximumError : float
+    Maximum absolute error."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::getMaximumError
+"Maximum error accessor.
+
+Returns
+-------
+maximumError : float
+    Maximum absolute error."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::setMaximumCallsNumber
+"Maximum number of calls accessor.
+
+Parameters
+----------
+maximumCallsNumber : int
+    Maximum number of evaluations of the integrand, beyond which the
+    refinement stops with a warning.
+    Default is given by the `SparseGridIntegration-DefaultMaximumCallsNumber`
+    key of :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::getMaximumCallsNumber
+"Maximum number of calls accessor.
+
+Returns
+-------
+maximumCallsNumber : int
+    Maximum number of evaluations of the integrand."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::setMaximumLevel
+"Maximum level accessor.
+
+Parameters
+----------
+maximumLevel : int, between 1 and 30
+    Maximum level of the one-dimensional rules, with :math:`2^l+1` nodes.
+    Default is given by the `SparseGridIntegration-DefaultMaximumLevel`
+    key of :py:class:`openturns.ResourceMap`."
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::SparseGridIntegration::getMaximumLevel
+"Maximum level accessor.
+
+Returns
+-------
+maximumLevel : int
+    Maximum level of the one-dimensional rules."
@@ -40,3 +40,37 @@ Examples
 [0.01])RAW"
 
 // ---------------------------------------------------------------------
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::VarianceMeasure::setControlVariate
+R"RAW(Taylor control variate accessor.
+
+When enabled, the variance over the nodes of a discrete distribution, of a
+discretization or of a fixed integration rule is corrected by the first-order
+Taylor expansion :math:`g(\theta) = f(x, \mu) + \nabla_\theta f(x, \mu)^T (\theta - \mu)`
+where :math:`\mu` and :math:`\Sigma` are the mean and covariance of the
+continuous distribution approximated by the nodes. With the coefficient
+:math:`c` fitted by weighted regression of :math:`f` on :math:`g` over the same
+nodes, the sampled variance
+:math:`c^2 \widehat{Var}(g)` of the expansion is replaced by its exact value
+:math:`c^2 \nabla_\theta f^T \Sigma \nabla_\theta f`.
+The ratio of the residual variance to the variance of the values is given by
+:meth:`getLastVarianceReduction`. The gradient and the hessian are not corrected.
+The default value is given by the `VarianceMeasure-ControlVariate` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+controlVariate : bool
+    Whether the Taylor control variate is used)RAW"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::VarianceMeasure::getControlVariate
+"Taylor control variate accessor.
+
+Returns
+-------
+controlVariate : bool
+    Whether the Taylor control variate is used"
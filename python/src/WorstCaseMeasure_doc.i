@@ -76,3 +76,55 @@ Returns
 -------
 solver : :py:class:`openturns.OptimizationAlgorithm`
     Optimization solver"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::WorstCaseMeasure::setStartingPointsNumber
+"Number of starting points accessor.
+
+In case of a continuous distribution, the inner optimization is started from
+the mean of the distribution and from `n-1` points of a Halton design of the
+distribution. The best optimum is retained.
+The default value is given by the `WorstCaseMeasure-StartingPointsNumber` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+n : int
+    Number of starting points"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::WorstCaseMeasure::getStartingPointsNumber
+"Number of starting points accessor.
+
+Returns
+-------
+n : int
+    Number of starting points"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::WorstCaseMeasure::setWarmStartCacheSize
+"Warm start cache size accessor.
+
+In case of a continuous distribution, the optimal parameters found at the
+last `n` design points are kept, and the inner optimizations at a new point
+start from those of the nearest cached point. A size of 0 disables the cache.
+The default value is given by the `WorstCaseMeasure-WarmStartCacheSize` key
+of the :class:`openturns.ResourceMap`.
+
+Parameters
+----------
+n : int
+    Maximum number of cached design points"
+
+// ---------------------------------------------------------------------
+
+%feature("docstring") OTROBOPT::WorstCaseMeasure::getWarmStartCacheSize
+"Warm start cache size accessor.
+
+Returns
+-------
+n : int
+    Maximum number of cached design points"
@@ -28,11 +28,16 @@
 %include AggregatedMeasure.i
 %include JointChanceMeasure.i
 %include IndividualChanceMeasure.i
+%include MeasureGradient.i
+%include MeasureHessian.i
 %include MeasureFunction.i
 %include MeasureFactory.i
+%include QuasiMonteCarloIntegration.i
+%include SparseGridIntegration.i
 %include RobustOptimizationProblem.i
 %include RobustOptimizationAlgorithm.i
 %include SequentialMonteCarloRobustAlgorithm.i
+%include AdaptiveIntegrationRobustAlgorithm.i
 %include SubsetInverseSamplingResult.i
 %include SubsetInverseSampling.i
 %include InverseFORMResult.i
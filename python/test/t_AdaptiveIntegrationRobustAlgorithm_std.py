@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+
+import openturns as ot
+import otrobopt
+
+thetaDist = ot.Normal(2.0, 0.1)
+
+# The integration accuracy is tightened along the robust optimization
+distance = ot.ParametricFunction(ot.SymbolicFunction(['x', 'theta'], ['(x-theta)^2']), [1], [2.0])
+problem = otrobopt.RobustOptimizationProblem()
+problem.setRobustnessMeasure(otrobopt.MeanMeasure(distance, thetaDist))
+solver = ot.Cobyla()
+solver.setStartingPoint([0.0])
+algo = otrobopt.AdaptiveIntegrationRobustAlgorithm(problem, solver)
+algo.setMaximumIterationNumber(10)
+print(algo)
+algo.run()
+optimum = algo.getResult().getOptimalPoint()
+assert abs(optimum[0] - 2.0) < 1e-3, 'optimum=%s' % optimum
+print('optimum=%.3g' % optimum[0])
+
+# The smoothing bandwidth of a chance constraint shrinks along with the accuracy:
+# P(theta - x >= 0) >= 0.9 bounds x by the 0.1 quantile of theta
+margin = ot.ParametricFunction(ot.SymbolicFunction(['x', 'theta'], ['theta-x']), [1], [2.0])
+reliability = otrobopt.JointChanceMeasure(margin, thetaDist, ot.GreaterOrEqual(), 0.9)
+reliability.setSmoothingBandwidth(1e-2)
+reliability.setFinalSmoothingBandwidth(1e-3)
+constrainedProblem = otrobopt.RobustOptimizationProblem(otrobopt.MeanMeasure(distance, thetaDist), reliability)
+constrainedAlgo = otrobopt.AdaptiveIntegrationRobustAlgorithm(constrainedProblem, solver)
+constrainedAlgo.setInitialMaximumError(1e-4)
+constrainedAlgo.setFinalMaximumError(1e-8)
+constrainedAlgo.setMaximumIterationNumber(10)
+print(constrainedAlgo)
+constrainedAlgo.run()
+constrainedOptimum = constrainedAlgo.getResult().getOptimalPoint()
+bound = thetaDist.computeQuantile(0.1)[0]
+assert abs(constrainedOptimum[0] - bound) < 1e-2, 'constrained optimum=%s' % constrainedOptimum
+print('constrained optimum=%.2g' % constrainedOptimum[0])
@@ -0,0 +1,33 @@
+#!/usr/bin/env python
+
+import openturns as ot
+import otrobopt
+
+algorithm = otrobopt.QuasiMonteCarloIntegration(65536, ot.HaltonSequence())
+print('size=', algorithm.getSize(),
+      'replicationsNumber=', algorithm.getReplicationsNumber())
+
+# The nodes are uniform over the interval, split into the replications
+interval = ot.Interval(0.0, 3.0)
+nodes, weights = algorithm.generateWithWeights(interval)
+print('nodes=', nodes.getSize(), 'weights sum=%.6g' % sum(weights))
+
+# The error is the standard deviation of the estimate over the replications
+f = ot.SymbolicFunction(['t'], ['t^2'])
+integral, error = algorithm.integrateWithError(f, interval)
+assert abs(integral[0] - 9.0) < 1e-2 and error[0] < 1e-2, 'integral=%s' % integral
+print('integral=%.2g' % integral[0])
+
+# A single replication is the plain sequence, without error estimate
+algorithm.setReplicationsNumber(1)
+integral, error = algorithm.integrateWithError(f, interval)
+assert abs(integral[0] - 9.0) < 1e-2 and error[0] == 0.0, 'integral=%s' % integral
+print('plain integral=%.2g' % integral[0], 'error=%g' % error[0])
+
+# The nodes can be drawn from a distribution, the integrand is then divided by its density
+normalAlgorithm = otrobopt.QuasiMonteCarloIntegration(4096)
+normalAlgorithm.setDistribution(ot.Normal(2.0, 0.5))
+g = ot.SymbolicFunction(['t'], ['t*exp(-(t-2)^2/0.5)/sqrt(0.5*_pi)'])
+integral, error = normalAlgorithm.integrateWithError(g, ot.Interval(-2.0, 6.0))
+assert abs(integral[0] - 2.0) < 1e-2 and error[0] < 1e-2, 'integral=%s' % integral
+print('normal integral=%.2g' % integral[0])
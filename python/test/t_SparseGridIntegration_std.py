@@ -0,0 +1,26 @@
+#!/usr/bin/env python
+
+import openturns as ot
+import otrobopt
+import math
+
+algorithm = otrobopt.SparseGridIntegration(1e-8)
+print(algorithm)
+
+# The nested Clenshaw-Curtis rules are exact for the polynomials of low degree
+f = ot.SymbolicFunction(['t0', 't1'], ['t0^2*t1'])
+integral, error = algorithm.integrateWithError(f, ot.Interval([0.0] * 2, [1.0] * 2))
+assert abs(integral[0] - 1.0 / 6.0) < 1e-12 and error[0] <= 1e-8, 'integral=%s' % integral
+print('polynomial integral=%.6g' % integral[0])
+
+# The sparse grid refines the dimensions of a smooth integrand
+f = ot.SymbolicFunction(['t0', 't1', 't2', 't3', 't4'], ['exp(t0+t1+t2+t3+t4)'])
+integral, error = algorithm.integrateWithError(f, ot.Interval([0.0] * 5, [1.0] * 5))
+assert abs(integral[0] - (math.e - 1.0) ** 5) < 1e-6 and error[0] <= 1e-8, 'integral=%s' % integral
+print('exponential integral=%.6g' % integral[0])
+
+# Over any interval
+f = ot.SymbolicFunction(['t'], ['exp(t)'])
+integral, error = algorithm.integrateWithError(f, ot.Interval(-1.0, 2.0))
+assert abs(integral[0] - (math.exp(2.0) - math.exp(-1.0))) < 1e-6 and error[0] <= 1e-8, 'integral=%s' % integral
+print('scaled integral=%.6g' % integral[0])
@@ -69,6 +69,21 @@ algo.setInitialSearch(1000)
 # number of multi-start tries, uniform law using bounds
 myStudy.add('algo', algo)
 
+quasiMonteCarlo = otrobopt.QuasiMonteCarloIntegration(2048, ot.HaltonSequence())
+quasiMonteCarlo.setReplicationsNumber(4)
+myStudy.add('quasiMonteCarlo', quasiMonteCarlo)
+
+sparseGrid = otrobopt.SparseGridIntegration(1e-6)
+sparseGrid.setMaximumCallsNumber(5000)
+sparseGrid.setMaximumLevel(8)
+myStudy.add('sparseGrid', sparseGrid)
+
+adaptiveAlgo = otrobopt.AdaptiveIntegrationRobustAlgorithm(problem, ot.Cobyla())
+adaptiveAlgo.setInitialMaximumError(1e-2)
+adaptiveAlgo.setFinalMaximumError(1e-8)
+adaptiveAlgo.setErrorReductionFactor(0.1)
+myStudy.add('adaptiveAlgo', adaptiveAlgo)
+
 myStudy.save()
 
 # Create a new Study Object
@@ -94,5 +109,18 @@ algo = otrobopt.SequentialMonteCarloRobustAlgorithm()
 myStudy.fillObject('algo', algo)
 print('algo= ', algo)
 
+quasiMonteCarlo = otrobopt.QuasiMonteCarloIntegration()
+myStudy.fillObject('quasiMonteCarlo', quasiMonteCarlo)
+print('quasiMonteCarlo= ', quasiMonteCarlo.getSize(), quasiMonteCarlo.getReplicationsNumber(),
+      quasiMonteCarlo.getSequence().getImplementation().getClassName())
+
+sparseGrid = otrobopt.SparseGridIntegration()
+myStudy.fillObject('sparseGrid', sparseGrid)
+print('sparseGrid= ', sparseGrid)
+
+adaptiveAlgo = otrobopt.AdaptiveIntegrationRobustAlgorithm()
+myStudy.fillObject('adaptiveAlgo', adaptiveAlgo)
+print('adaptiveAlgo= ', adaptiveAlgo)
+
 # cleanup
 os.remove(fileName)